@@ -0,0 +1,572 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#define LIBVERSION_NO_DEPRECATED /* disable deprecated APIs */
+
+#include <libversion/version.h>
+#include <libversion/hardened.h>
+#include <libversion/keywords.h>
+#include <libversion/private/compare.h>
+#include <libversion/private/parse.h>
+#include <libversion/private/string.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+#	include <windows.h>
+#endif
+
+/* Microbenchmarks for comparison core. Each benchmark is run for
+ * warmup period, then for a number of repetitions, each long enough
+ * to make timer resolution irrelevant; per-repetition ns/op figures
+ * are summarized with median and percentiles. */
+
+static const char* short_versions[] = {
+	"1.0", "1.0.1", "1.2", "1.2.3", "1.10", "2.0", "2.0.0", "0.9",
+	"3.1.4", "10.0", "1.2.3.4", "0.99", "4.19.2", "5.15", "1.1.1", "2",
+};
+
+static const char* long_versions[] = {
+	"20240131.1.2.3.4.5.6.7.8.9.10.11.12",
+	"20240131.1.2.3.4.5.6.7.8.9.10.11.13",
+	"0.0.0-20240131120000-abcdef123456",
+	"0.0.0-20240131120000-abcdef123457",
+	"1.2.3.4.5.6.7.8.9.10.11.12.13.14.15.16.17.18.19.20",
+	"1.2.3.4.5.6.7.8.9.10.11.12.13.14.15.16.17.18.19.21",
+	"2023.12.31.235959.snapshot.git.deadbeef",
+	"2023.12.31.235959.snapshot.git.deadbeee",
+};
+
+static const char* keyword_versions[] = {
+	"1.0alpha1", "1.0beta2", "1.0pre3", "1.0rc1", "1.0", "1.0patch1", "1.0post2", "1.0pl3",
+	"1.0errata1", "1.0a", "1.0b", "1.0p1", "2.0-rc.1", "2.0.beta.3", "2.0alpha1beta2", "2.0preview1",
+};
+
+static const char* adversarial_versions[] = {
+	"000000000000000000000000000000000000000000000000000000000001",
+	"000000000000000000000000000000000000000000000000000000000002",
+	"123456789012345678901234567890123456789012345678901234567890",
+	"123456789012345678901234567890123456789012345678901234567891",
+	"1..............................................................2",
+	"1--------------------------------------------------------------3",
+	"a1b2c3d4e5f6g7h8i9j0k1l2m3n4o5p6q7r8s9t0u1v2w3x4y5z6",
+	"a1b2c3d4e5f6g7h8i9j0k1l2m3n4o5p6q7r8s9t0u1v2w3x4y5z7",
+	"0.0.0.0.0.0.0.0.0.0.0.0.0.0.0.0.0.0.0.0.0.0.0.0.0.0.0.0.0.0.1",
+	"0.0.0.0.0.0.0.0.0.0.0.0.0.0.0.0.0.0.0.0.0.0.0.0.0.0.0.0.0.0",
+	"abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz",
+	"ABCDEFGHIJKLMNOPQRSTUVWXYZABCDEFGHIJKLMNOPQRSTUVWXYZ",
+};
+
+#define COUNT(a) (sizeof(a)/sizeof(a[0]))
+
+typedef struct {
+	const char* name;
+	const char** versions;
+	size_t count;
+} input_t;
+
+static const input_t inputs[] = {
+	{ "short", short_versions, COUNT(short_versions) },
+	{ "long", long_versions, COUNT(long_versions) },
+	{ "keyword", keyword_versions, COUNT(keyword_versions) },
+	{ "adversarial", adversarial_versions, COUNT(adversarial_versions) },
+};
+
+/* huge versions of a single repeated character, generated at startup,
+ * to show how plain and hardened comparison latency grows with input size */
+typedef struct {
+	const char* name;
+	char fill;
+} huge_shape_t;
+
+static const huge_shape_t huge_shapes[] = {
+	{ "digits", '1' },
+	{ "zeroes", '0' },
+	{ "separators", '.' },
+};
+
+static const size_t huge_sizes[] = { 1024, 65536, 1048576 };
+
+static const version_limits_t hardened_limits = { 256, 32 };
+
+typedef struct {
+	const char* name;
+	int flags1;
+	int flags2;
+} flags_t;
+
+static const flags_t compare4_flags[] = {
+	{ "none", 0, 0 },
+	{ "p_is_patch", VERSIONFLAG_P_IS_PATCH, VERSIONFLAG_P_IS_PATCH },
+	{ "any_is_patch", VERSIONFLAG_ANY_IS_PATCH, VERSIONFLAG_ANY_IS_PATCH },
+	{ "lower_bound", 0, VERSIONFLAG_LOWER_BOUND },
+	{ "upper_bound", 0, VERSIONFLAG_UPPER_BOUND },
+};
+
+/* components of all versions of an input, for compare_components benchmark */
+typedef struct {
+	component_t* components;
+	size_t count;
+} tokenized_t;
+
+typedef struct {
+	const input_t* input;
+	const flags_t* flags;
+	const version_keywords_t* keywords;
+	tokenized_t tokenized;
+} context_t;
+
+/* each function performs one pass over an input and returns number of operations done */
+typedef size_t (*bench_func_t)(const context_t* context);
+
+static volatile int sink;
+
+static size_t bench_compare2(const context_t* context) {
+	const input_t* input = context->input;
+	size_t i, j;
+	int acc = 0;
+
+	for (i = 0; i < input->count; i++)
+		for (j = 0; j < input->count; j++)
+			acc += version_compare2(input->versions[i], input->versions[j]);
+
+	sink = acc;
+	return input->count * input->count;
+}
+
+static size_t bench_compare4(const context_t* context) {
+	const input_t* input = context->input;
+	const flags_t* flags = context->flags;
+	size_t i, j;
+	int acc = 0;
+
+	for (i = 0; i < input->count; i++)
+		for (j = 0; j < input->count; j++)
+			acc += version_compare4(input->versions[i], input->versions[j], flags->flags1, flags->flags2);
+
+	sink = acc;
+	return input->count * input->count;
+}
+
+static size_t bench_keywords(const context_t* context) {
+	const input_t* input = context->input;
+	size_t i, j;
+	int acc = 0;
+
+	for (i = 0; i < input->count; i++)
+		for (j = 0; j < input->count; j++)
+			acc += version_keywords_compare4(context->keywords, input->versions[i], input->versions[j], 0, 0);
+
+	sink = acc;
+	return input->count * input->count;
+}
+
+static size_t bench_hardened(const context_t* context) {
+	const input_t* input = context->input;
+	size_t i, j;
+	int acc = 0;
+
+	for (i = 0; i < input->count; i++)
+		for (j = 0; j < input->count; j++)
+			acc += version_hardened_compare4(&hardened_limits, input->versions[i], input->versions[j], 0, 0);
+
+	sink = acc;
+	return input->count * input->count;
+}
+
+static size_t bench_abbreviated_key(const context_t* context) {
+	const input_t* input = context->input;
+	uint64_t acc = 0;
+	size_t i;
+
+	for (i = 0; i < input->count; i++)
+		acc += version_abbreviated_key(input->versions[i], 0);
+
+	sink = (int)acc;
+	return input->count;
+}
+
+static size_t bench_tokenize(const context_t* context) {
+	const input_t* input = context->input;
+	component_t components[2];
+	size_t i, ops = 0;
+	int acc = 0;
+
+	for (i = 0; i < input->count; i++) {
+		const char* v = input->versions[i];
+		while (*skip_separator(v) != '\0') {
+			acc += (int)get_next_version_component(&v, components, 0);
+			acc += components[0].metaorder;
+			ops++;
+		}
+	}
+
+	sink = acc;
+	return ops;
+}
+
+static size_t bench_compare_components(const context_t* context) {
+	const tokenized_t* tokenized = &context->tokenized;
+	size_t i, j;
+	int acc = 0;
+
+	for (i = 0; i < tokenized->count; i++)
+		for (j = 0; j < tokenized->count; j++)
+			acc += compare_components(&tokenized->components[i], &tokenized->components[j]);
+
+	sink = acc;
+	return tokenized->count * tokenized->count;
+}
+
+static int tokenize_input(const input_t* input, tokenized_t* tokenized) {
+	component_t components[2];
+	size_t capacity = 0, i, len, k;
+
+	tokenized->components = NULL;
+	tokenized->count = 0;
+
+	for (i = 0; i < input->count; i++) {
+		const char* v = input->versions[i];
+		while (*skip_separator(v) != '\0') {
+			len = get_next_version_component(&v, components, 0);
+			for (k = 0; k < len; k++) {
+				if (tokenized->count == capacity) {
+					component_t* grown;
+					capacity = capacity ? capacity * 2 : 64;
+					if ((grown = realloc(tokenized->components, capacity * sizeof(component_t))) == NULL)
+						return 0;
+					tokenized->components = grown;
+				}
+				tokenized->components[tokenized->count++] = components[k];
+			}
+		}
+	}
+
+	return 1;
+}
+
+/* two versions differing only in the last character */
+static int make_huge_input(const huge_shape_t* shape, size_t size, input_t* input, char** versions) {
+	size_t i;
+
+	for (i = 0; i < 2; i++) {
+		if ((versions[i] = malloc(size + 1)) == NULL)
+			return 0;
+		memset(versions[i], shape->fill, size - 1);
+		versions[i][size - 1] = '1' + (char)i;
+		versions[i][size] = '\0';
+	}
+
+	input->name = shape->name;
+	input->versions = (const char**)versions;
+	input->count = 2;
+
+	return 1;
+}
+
+static double now_ns(void) {
+#ifdef _WIN32
+	LARGE_INTEGER counter, frequency;
+	QueryPerformanceCounter(&counter);
+	QueryPerformanceFrequency(&frequency);
+	return (double)counter.QuadPart * 1e9 / (double)frequency.QuadPart;
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+#endif
+}
+
+typedef struct {
+	double warmup_ms;
+	double min_time_ms;
+	size_t repetitions;
+	const char* filter;
+} options_t;
+
+typedef struct {
+	char name[128];
+	size_t repetitions;
+	size_t ops_per_repetition;
+	double min;
+	double median;
+	double p90;
+	double p99;
+	double max;
+	double mean;
+} result_t;
+
+static int compare_doubles(const void* a, const void* b) {
+	double da = *(const double*)a;
+	double db = *(const double*)b;
+	return (da > db) - (da < db);
+}
+
+/* nearest-rank percentile over sorted samples */
+static double percentile(const double* sorted, size_t count, double p) {
+	size_t rank = (size_t)(p / 100.0 * (double)count + 0.999999);
+	if (rank < 1)
+		rank = 1;
+	if (rank > count)
+		rank = count;
+	return sorted[rank - 1];
+}
+
+static int run_benchmark(const options_t* options, bench_func_t func, const context_t* context, result_t* result) {
+	double* samples;
+	double start, elapsed, deadline;
+	size_t passes = 1, ops, pass, i;
+	double sum = 0;
+
+	if ((samples = malloc(options->repetitions * sizeof(double))) == NULL)
+		return 0;
+
+	/* warmup, also calibrates number of passes per repetition */
+	deadline = now_ns() + options->warmup_ms * 1e6;
+	do {
+		start = now_ns();
+		for (pass = 0; pass < passes; pass++)
+			func(context);
+		elapsed = now_ns() - start;
+		if (elapsed < options->min_time_ms * 1e6)
+			passes *= 2;
+	} while (now_ns() < deadline || elapsed < options->min_time_ms * 1e6);
+
+	for (i = 0; i < options->repetitions; i++) {
+		ops = 0;
+		start = now_ns();
+		for (pass = 0; pass < passes; pass++)
+			ops += func(context);
+		elapsed = now_ns() - start;
+		samples[i] = elapsed / (double)ops;
+		sum += samples[i];
+		result->ops_per_repetition = ops;
+	}
+
+	qsort(samples, options->repetitions, sizeof(double), compare_doubles);
+
+	result->repetitions = options->repetitions;
+	result->min = samples[0];
+	result->median = options->repetitions % 2 ? samples[options->repetitions / 2] : (samples[options->repetitions / 2 - 1] + samples[options->repetitions / 2]) / 2;
+	result->p90 = percentile(samples, options->repetitions, 90);
+	result->p99 = percentile(samples, options->repetitions, 99);
+	result->max = samples[options->repetitions - 1];
+	result->mean = sum / (double)options->repetitions;
+
+	free(samples);
+	return 1;
+}
+
+typedef struct {
+	result_t* items;
+	size_t count;
+	size_t capacity;
+} results_t;
+
+static int add_benchmark(const options_t* options, results_t* results, const char* name, bench_func_t func, const context_t* context) {
+	result_t* result;
+
+	if (options->filter != NULL && strstr(name, options->filter) == NULL)
+		return 1;
+
+	if (results->count == results->capacity) {
+		result_t* grown;
+		results->capacity = results->capacity ? results->capacity * 2 : 32;
+		if ((grown = realloc(results->items, results->capacity * sizeof(result_t))) == NULL)
+			return 0;
+		results->items = grown;
+	}
+
+	result = &results->items[results->count++];
+	memset(result, 0, sizeof(result_t));
+	snprintf(result->name, sizeof(result->name), "%s", name);
+
+	if (!run_benchmark(options, func, context, result))
+		return 0;
+
+	printf("%-40s %10.2f ns/op %14.0f ops/s  (min %.2f, p90 %.2f, p99 %.2f)\n",
+		result->name, result->median, 1e9 / result->median, result->min, result->p90, result->p99);
+	fflush(stdout);
+
+	return 1;
+}
+
+static int write_json(const char* path, const options_t* options, const results_t* results) {
+	FILE* f;
+	size_t i;
+
+	if ((f = fopen(path, "w")) == NULL)
+		return 0;
+
+	fprintf(f, "{\n");
+	fprintf(f, "  \"library\": \"libversion\",\n");
+	fprintf(f, "  \"version\": \"%s\",\n", LIBVERSION_VERSION);
+	fprintf(f, "  \"warmup_ms\": %g,\n", options->warmup_ms);
+	fprintf(f, "  \"min_time_ms\": %g,\n", options->min_time_ms);
+	fprintf(f, "  \"benchmarks\": [\n");
+	for (i = 0; i < results->count; i++) {
+		const result_t* r = &results->items[i];
+		fprintf(f, "    {\n");
+		fprintf(f, "      \"name\": \"%s\",\n", r->name);
+		fprintf(f, "      \"repetitions\": %lu,\n", (unsigned long)r->repetitions);
+		fprintf(f, "      \"ops_per_repetition\": %lu,\n", (unsigned long)r->ops_per_repetition);
+		fprintf(f, "      \"ns_per_op\": { \"min\": %.3f, \"median\": %.3f, \"p90\": %.3f, \"p99\": %.3f, \"max\": %.3f, \"mean\": %.3f },\n",
+			r->min, r->median, r->p90, r->p99, r->max, r->mean);
+		fprintf(f, "      \"ops_per_second\": %.0f\n", 1e9 / r->median);
+		fprintf(f, "    }%s\n", i + 1 < results->count ? "," : "");
+	}
+	fprintf(f, "  ]\n");
+	fprintf(f, "}\n");
+
+	return fclose(f) == 0;
+}
+
+static void print_usage(const char* progname) {
+	fprintf(stderr, "Usage: %s [-r repetitions] [-t ms] [-w ms] [-f filter] [-o output.json]\n", progname);
+	fprintf(stderr, "\n");
+	fprintf(stderr, " -r repetitions - number of measured repetitions (default 15)\n");
+	fprintf(stderr, " -t ms          - minimal duration of a repetition (default 20)\n");
+	fprintf(stderr, " -w ms          - warmup duration per benchmark (default 100)\n");
+	fprintf(stderr, " -f filter      - only run benchmarks with names containing filter\n");
+	fprintf(stderr, " -o path        - write results as JSON\n");
+}
+
+static int parse_number(const char* arg, double* value) {
+	char* end;
+	*value = strtod(arg, &end);
+	return *arg != '\0' && *end == '\0' && *value > 0;
+}
+
+int main(int argc, char** argv) {
+	options_t options = { 100, 20, 15, NULL };
+	const char* output = NULL;
+	results_t results = { NULL, 0, 0 };
+	context_t context;
+	char name[128];
+	double value;
+	input_t huge_input;
+	char* huge_versions[2];
+	version_keywords_t* default_keywords;
+	size_t iinput, iflags, ishape, isize;
+	int i, ok = 1;
+
+	/* no getopt here, as this should build on Windows as well */
+	for (i = 1; i < argc; i++) {
+		if (i + 1 < argc && strcmp(argv[i], "-r") == 0 && parse_number(argv[i + 1], &value)) {
+			options.repetitions = (size_t)value;
+		} else if (i + 1 < argc && strcmp(argv[i], "-t") == 0 && parse_number(argv[i + 1], &value)) {
+			options.min_time_ms = value;
+		} else if (i + 1 < argc && strcmp(argv[i], "-w") == 0 && parse_number(argv[i + 1], &value)) {
+			options.warmup_ms = value;
+		} else if (i + 1 < argc && strcmp(argv[i], "-f") == 0) {
+			options.filter = argv[i + 1];
+		} else if (i + 1 < argc && strcmp(argv[i], "-o") == 0) {
+			output = argv[i + 1];
+		} else {
+			print_usage(argv[0]);
+			return 1;
+		}
+		i++;
+	}
+
+	if (options.repetitions == 0) {
+		print_usage(argv[0]);
+		return 1;
+	}
+
+	ok = (default_keywords = version_keywords_build(NULL, 0, VERSIONKEYWORDS_DEFAULT)) != NULL;
+
+	for (iinput = 0; iinput < COUNT(inputs) && ok; iinput++) {
+		memset(&context, 0, sizeof(context));
+		context.input = &inputs[iinput];
+
+		snprintf(name, sizeof(name), "compare2/%s", inputs[iinput].name);
+		ok = ok && add_benchmark(&options, &results, name, bench_compare2, &context);
+
+		for (iflags = 0; iflags < COUNT(compare4_flags); iflags++) {
+			context.flags = &compare4_flags[iflags];
+			snprintf(name, sizeof(name), "compare4/%s/%s", compare4_flags[iflags].name, inputs[iinput].name);
+			ok = ok && add_benchmark(&options, &results, name, bench_compare4, &context);
+		}
+
+		/* same comparisons as compare4/none, through keyword profile API */
+		context.keywords = NULL;
+		snprintf(name, sizeof(name), "keywords/null/%s", inputs[iinput].name);
+		ok = ok && add_benchmark(&options, &results, name, bench_keywords, &context);
+
+		context.keywords = default_keywords;
+		snprintf(name, sizeof(name), "keywords/default/%s", inputs[iinput].name);
+		ok = ok && add_benchmark(&options, &results, name, bench_keywords, &context);
+
+		snprintf(name, sizeof(name), "hardened/%s", inputs[iinput].name);
+		ok = ok && add_benchmark(&options, &results, name, bench_hardened, &context);
+
+		snprintf(name, sizeof(name), "abbreviated_key/%s", inputs[iinput].name);
+		ok = ok && add_benchmark(&options, &results, name, bench_abbreviated_key, &context);
+
+		snprintf(name, sizeof(name), "tokenize/%s", inputs[iinput].name);
+		ok = ok && add_benchmark(&options, &results, name, bench_tokenize, &context);
+
+		ok = ok && tokenize_input(&inputs[iinput], &context.tokenized);
+		snprintf(name, sizeof(name), "compare_components/%s", inputs[iinput].name);
+		ok = ok && add_benchmark(&options, &results, name, bench_compare_components, &context);
+		free(context.tokenized.components);
+	}
+
+	for (ishape = 0; ishape < COUNT(huge_shapes) && ok; ishape++) {
+		for (isize = 0; isize < COUNT(huge_sizes) && ok; isize++) {
+			huge_versions[0] = huge_versions[1] = NULL;
+			memset(&context, 0, sizeof(context));
+			context.input = &huge_input;
+			context.flags = &compare4_flags[0];
+
+			ok = make_huge_input(&huge_shapes[ishape], huge_sizes[isize], &huge_input, huge_versions);
+
+			snprintf(name, sizeof(name), "compare4/huge/%s/%lu", huge_shapes[ishape].name, (unsigned long)huge_sizes[isize]);
+			ok = ok && add_benchmark(&options, &results, name, bench_compare4, &context);
+
+			snprintf(name, sizeof(name), "hardened/huge/%s/%lu", huge_shapes[ishape].name, (unsigned long)huge_sizes[isize]);
+			ok = ok && add_benchmark(&options, &results, name, bench_hardened, &context);
+
+			free(huge_versions[0]);
+			free(huge_versions[1]);
+		}
+	}
+
+	if (!ok) {
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+
+	if (output != NULL && !write_json(output, &options, &results)) {
+		fprintf(stderr, "cannot write %s\n", output);
+		return 1;
+	}
+
+	free(results.items);
+	version_keywords_free(default_keywords);
+
+	return 0;
+}
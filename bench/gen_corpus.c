@@ -0,0 +1,416 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#define LIBVERSION_NO_DEPRECATED /* disable deprecated APIs */
+
+#include <libversion/version.h>
+#include <libversion/private/random.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Deterministic generator of version corpora for benchmarking. Versions
+ * are drawn from a weighted mix of shapes seen in real package data,
+ * and output may be arranged in a given order. Random order is streamed
+ * and takes constant memory, other orders are arranged in memory. */
+
+enum {
+	SHAPE_NUMERIC,
+	SHAPE_DATE,
+	SHAPE_VCS,
+	SHAPE_KEYWORD,
+	SHAPE_EPOCH,
+	SHAPE_GARBAGE,
+	NUM_SHAPES
+};
+
+static const char* shape_names[NUM_SHAPES] = { "numeric", "date", "vcs", "keyword", "epoch", "garbage" };
+
+enum {
+	ORDER_RANDOM,
+	ORDER_SORTED,
+	ORDER_NEARLY_SORTED,
+	ORDER_REVERSED,
+	ORDER_DUPLICATES,
+	NUM_ORDERS
+};
+
+static const char* order_names[NUM_ORDERS] = { "random", "sorted", "nearly-sorted", "reversed", "duplicates" };
+
+#define COUNT(a) (sizeof(a)/sizeof(a[0]))
+#define MAX_VERSION_LENGTH 128
+
+static unsigned random_below(uint64_t* state, unsigned n) {
+	return (unsigned)(next_random(state) % n);
+}
+
+/* small numbers are more common */
+static unsigned random_skewed(uint64_t* state, unsigned n) {
+	unsigned a = random_below(state, n), b = random_below(state, n);
+	return a < b ? a : b;
+}
+
+static size_t put_numeric(uint64_t* state, char* buf, size_t size, unsigned max_components) {
+	static const unsigned component_weights[] = { 5, 30, 50, 15 };
+	unsigned roll = random_below(state, 100), components = 1, i;
+	size_t length;
+
+	for (i = 0; i + 1 < COUNT(component_weights) && roll >= component_weights[i]; i++) {
+		roll -= component_weights[i];
+		components++;
+	}
+	if (components > max_components)
+		components = max_components;
+
+	length = (size_t)snprintf(buf, size, "%u", random_skewed(state, 30));
+	for (i = 1; i < components; i++)
+		length += (size_t)snprintf(buf + length, size - length, ".%u", random_skewed(state, i == 1 ? 20 : 50));
+
+	return length;
+}
+
+static void make_version(uint64_t* state, int shape, char* buf, size_t size) {
+	static const char* keywords[] = { "alpha", "beta", "rc", "pre", "pl", "patch", "post", "a", "b", "p" };
+	static const char* separators[] = { "", "", ".", "-", "_" };
+	static const char garbage_chars[] = "abcxyzABCXYZ0123456789.-_+~:";
+
+	unsigned year = 2000 + random_below(state, 26), month = 1 + random_below(state, 12), day = 1 + random_below(state, 28);
+	size_t length, i;
+
+	switch (shape) {
+	case SHAPE_NUMERIC:
+		put_numeric(state, buf, size, 4);
+		break;
+	case SHAPE_DATE:
+		switch (random_below(state, 4)) {
+		case 0: snprintf(buf, size, "%04u%02u%02u", year, month, day); break;
+		case 1: snprintf(buf, size, "%04u.%02u.%02u", year, month, day); break;
+		case 2: snprintf(buf, size, "0.0.%04u%02u%02u", year, month, day); break;
+		default:
+			length = put_numeric(state, buf, size, 3);
+			snprintf(buf + length, size - length, ".%04u%02u%02u", year, month, day);
+		}
+		break;
+	case SHAPE_VCS:
+		switch (random_below(state, 4)) {
+		case 0:
+			length = put_numeric(state, buf, size, 3);
+			snprintf(buf + length, size - length, "+git%04u%02u%02u.%07lx", year, month, day, (unsigned long)(next_random(state) & 0xfffffff));
+			break;
+		case 1:
+			length = put_numeric(state, buf, size, 2);
+			snprintf(buf + length, size - length, ".r%u.g%07lx", random_below(state, 5000), (unsigned long)(next_random(state) & 0xfffffff));
+			break;
+		case 2:
+			length = put_numeric(state, buf, size, 2);
+			snprintf(buf + length, size - length, "~svn%u", random_below(state, 100000));
+			break;
+		default:
+			snprintf(buf, size, "0.0.0-%04u%02u%02u%06u-%012llx", year, month, day, random_below(state, 240000),
+				(unsigned long long)(next_random(state) & 0xffffffffffffULL));
+		}
+		break;
+	case SHAPE_KEYWORD:
+		length = put_numeric(state, buf, size, 3);
+		snprintf(buf + length, size - length, "%s%s%u",
+			separators[random_below(state, COUNT(separators))], keywords[random_below(state, COUNT(keywords))], 1 + random_skewed(state, 9));
+		break;
+	case SHAPE_EPOCH:
+		length = (size_t)snprintf(buf, size, "%u:", 1 + random_skewed(state, 3));
+		length += put_numeric(state, buf + length, size - length, 4);
+		snprintf(buf + length, size - length, "-%u", 1 + random_skewed(state, 10));
+		break;
+	default:
+		length = 1 + random_below(state, 16);
+		for (i = 0; i < length && i + 1 < size; i++)
+			buf[i] = garbage_chars[random_below(state, sizeof(garbage_chars) - 1)];
+		buf[i] = '\0';
+	}
+}
+
+typedef struct {
+	unsigned weights[NUM_SHAPES];
+	unsigned total;
+} mix_t;
+
+static int make_random_version(uint64_t* state, const mix_t* mix, char* buf, size_t size) {
+	unsigned roll = random_below(state, mix->total);
+	int shape;
+
+	for (shape = 0; shape + 1 < NUM_SHAPES && roll >= mix->weights[shape]; shape++)
+		roll -= mix->weights[shape];
+
+	make_version(state, shape, buf, size);
+	return shape;
+}
+
+/* parses comma separated list of shape=weight; unmentioned shapes get zero weight */
+static int parse_mix(const char* arg, mix_t* mix) {
+	const char* cur = arg;
+	char* end;
+	size_t len;
+	int shape;
+
+	memset(mix, 0, sizeof(mix_t));
+
+	while (*cur != '\0') {
+		for (shape = 0; shape < NUM_SHAPES; shape++) {
+			len = strlen(shape_names[shape]);
+			if (strncmp(cur, shape_names[shape], len) == 0 && cur[len] == '=')
+				break;
+		}
+		if (shape == NUM_SHAPES)
+			return 0;
+
+		cur += strlen(shape_names[shape]) + 1;
+		mix->weights[shape] = (unsigned)strtoul(cur, &end, 10);
+		if (end == cur || (*end != ',' && *end != '\0'))
+			return 0;
+		mix->total += mix->weights[shape];
+		cur = *end == ',' ? end + 1 : end;
+	}
+
+	return mix->total > 0;
+}
+
+/* records are stored as key\0version\0 in a single arena; keys
+ * contain no zero bytes, so strcmp() orders records by key */
+typedef struct {
+	char* data;
+	size_t size;
+	size_t capacity;
+	size_t* offsets;
+	size_t count;
+} records_t;
+
+static const char* sort_arena;
+
+static int compare_records(const void* a, const void* b) {
+	const char* ra = sort_arena + *(const size_t*)a;
+	const char* rb = sort_arena + *(const size_t*)b;
+	int res = strcmp(ra, rb);
+
+	if (res != 0)
+		return res;
+
+	return strcmp(ra + strlen(ra) + 1, rb + strlen(rb) + 1);
+}
+
+static int append_record(records_t* records, const char* v) {
+	/* key is never longer than twice the version, so this is enough for key\0version\0 */
+	size_t required = MAX_VERSION_LENGTH * 4, version_length = strlen(v) + 1, key_length;
+	size_t capacity = records->capacity ? records->capacity : 1 << 20;
+	char* data;
+
+	if (records->capacity - records->size < required) {
+		while (capacity - records->size < required)
+			capacity *= 2;
+		if ((data = realloc(records->data, capacity)) == NULL)
+			return 0;
+		records->data = data;
+		records->capacity = capacity;
+	}
+
+	key_length = version_sort_key(v, 0, (unsigned char*)records->data + records->size, required - version_length - 1);
+
+	records->offsets[records->count++] = records->size;
+	records->data[records->size + key_length] = '\0';
+	memcpy(records->data + records->size + key_length + 1, v, version_length);
+	records->size += key_length + 1 + version_length;
+
+	return 1;
+}
+
+static const char* record_version(const records_t* records, size_t index) {
+	const char* record = records->data + records->offsets[index];
+	return record + strlen(record) + 1;
+}
+
+static int generate_arranged(FILE* out, uint64_t* state, const mix_t* mix, size_t lines, int order) {
+	records_t records = { NULL, 0, 0, NULL, 0 };
+	char buf[MAX_VERSION_LENGTH];
+	size_t i, j, tmp;
+
+	if ((records.offsets = malloc((lines ? lines : 1) * sizeof(size_t))) == NULL)
+		return 0;
+
+	for (i = 0; i < lines; i++) {
+		make_random_version(state, mix, buf, sizeof(buf));
+		if (!append_record(&records, buf))
+			goto error;
+	}
+
+	sort_arena = records.data;
+	qsort(records.offsets, records.count, sizeof(size_t), compare_records);
+
+	/* nearly sorted: about 1% of records are displaced by up to 16 positions */
+	if (order == ORDER_NEARLY_SORTED && lines > 1) {
+		for (i = 0; i < lines / 100; i++) {
+			size_t pos = random_below(state, (unsigned)(lines < UINT32_MAX ? lines : UINT32_MAX));
+			size_t distance = 1 + random_below(state, 16);
+			j = pos + distance < lines ? pos + distance : lines - 1;
+			tmp = records.offsets[pos];
+			records.offsets[pos] = records.offsets[j];
+			records.offsets[j] = tmp;
+		}
+	}
+
+	for (i = 0; i < lines; i++) {
+		fputs(record_version(&records, order == ORDER_REVERSED ? lines - 1 - i : i), out);
+		fputc('\n', out);
+	}
+
+	free(records.offsets);
+	free(records.data);
+	return 1;
+
+error:
+	free(records.offsets);
+	free(records.data);
+	return 0;
+}
+
+static int generate_duplicates(FILE* out, uint64_t* state, const mix_t* mix, size_t lines, size_t distinct) {
+	char (*pool)[MAX_VERSION_LENGTH];
+	size_t i;
+
+	if ((pool = malloc(distinct * sizeof(*pool))) == NULL)
+		return 0;
+
+	for (i = 0; i < distinct; i++)
+		make_random_version(state, mix, pool[i], sizeof(pool[i]));
+
+	for (i = 0; i < lines; i++) {
+		fputs(pool[next_random(state) % distinct], out);
+		fputc('\n', out);
+	}
+
+	free(pool);
+	return 1;
+}
+
+static int parse_order(const char* arg) {
+	int order;
+
+	for (order = 0; order < NUM_ORDERS; order++)
+		if (strcmp(arg, order_names[order]) == 0)
+			return order;
+
+	return -1;
+}
+
+static void print_usage(const char* progname) {
+	fprintf(stderr, "Usage: %s [-n lines] [-s seed] [-m mix] [-O order] [-u distinct] [-o path]\n", progname);
+	fprintf(stderr, "\n");
+	fprintf(stderr, " -n lines    - number of versions to generate (default 1000000)\n");
+	fprintf(stderr, " -s seed     - random seed (default 1)\n");
+	fprintf(stderr, " -m mix      - comma separated shape weights, default\n");
+	fprintf(stderr, "               numeric=70,date=8,vcs=8,keyword=8,epoch=3,garbage=3\n");
+	fprintf(stderr, " -O order    - random (default), sorted, nearly-sorted, reversed or duplicates\n");
+	fprintf(stderr, " -u distinct - number of distinct versions in duplicates order (default lines/100)\n");
+	fprintf(stderr, " -o path     - output file (default stdout)\n");
+}
+
+static int parse_size(const char* arg, size_t* value) {
+	char* end;
+	unsigned long long parsed = strtoull(arg, &end, 10);
+	if (*arg == '\0' || *end != '\0')
+		return 0;
+	*value = (size_t)parsed;
+	return 1;
+}
+
+int main(int argc, char** argv) {
+	mix_t mix;
+	size_t lines = 1000000, distinct = 0, seed = 1, i;
+	const char* output = NULL;
+	char buf[MAX_VERSION_LENGTH];
+	uint64_t state;
+	FILE* out = stdout;
+	int order = ORDER_RANDOM, ok = 1, arg;
+
+	parse_mix("numeric=70,date=8,vcs=8,keyword=8,epoch=3,garbage=3", &mix);
+
+	/* no getopt here, as this should build on Windows as well */
+	for (arg = 1; arg + 1 < argc && ok; arg += 2) {
+		const char* value = argv[arg + 1];
+		if (strcmp(argv[arg], "-n") == 0)
+			ok = parse_size(value, &lines);
+		else if (strcmp(argv[arg], "-s") == 0)
+			ok = parse_size(value, &seed);
+		else if (strcmp(argv[arg], "-u") == 0)
+			ok = parse_size(value, &distinct) && distinct > 0;
+		else if (strcmp(argv[arg], "-m") == 0)
+			ok = parse_mix(value, &mix);
+		else if (strcmp(argv[arg], "-O") == 0)
+			ok = (order = parse_order(value)) != -1;
+		else if (strcmp(argv[arg], "-o") == 0)
+			output = value;
+		else
+			ok = 0;
+	}
+
+	if (!ok || arg != argc) {
+		print_usage(argv[0]);
+		return 1;
+	}
+
+	/* xorshift state must not be zero */
+	state = ((uint64_t)seed ^ 0x9e3779b97f4a7c15ULL);
+	if (state == 0)
+		state = 0x9e3779b97f4a7c15ULL;
+
+	if (output != NULL && (out = fopen(output, "w")) == NULL) {
+		fprintf(stderr, "cannot open %s\n", output);
+		return 1;
+	}
+	setvbuf(out, NULL, _IOFBF, 1 << 16);
+
+	switch (order) {
+	case ORDER_RANDOM:
+		for (i = 0; i < lines; i++) {
+			make_random_version(&state, &mix, buf, sizeof(buf));
+			fputs(buf, out);
+			fputc('\n', out);
+		}
+		break;
+	case ORDER_DUPLICATES:
+		ok = generate_duplicates(out, &state, &mix, lines, distinct ? distinct : lines / 100 ? lines / 100 : 1);
+		break;
+	default:
+		ok = generate_arranged(out, &state, &mix, lines, order);
+	}
+
+	if (!ok) {
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+
+	if (ferror(out) || (output != NULL && fclose(out) != 0)) {
+		fprintf(stderr, "write error\n");
+		return 1;
+	}
+
+	return 0;
+}
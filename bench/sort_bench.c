@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <libversion/config.h>
+
+/* End-to-end benchmark of version_sort: generates corpora of given
+ * sizes and orders with gen_corpus, sorts each with version_sort and
+ * measures wall time and peak resident memory of the sort process. */
+
+#define MAX_ITEMS 16
+#define MAX_EXTRA_ARGS 16
+
+typedef struct {
+	size_t lines;
+	const char* order;
+	unsigned long long bytes;
+	double wall;       /* median of repetitions, seconds */
+	double wall_min;
+	long peak_rss_kb;  /* maximum over repetitions */
+} result_t;
+
+static double now_seconds(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/* runs command with stdout redirected to given path, returns exit status or -1 */
+static int run(char* const* args, const char* stdout_path, struct rusage* usage) {
+	pid_t pid;
+	int status, fd;
+
+	if ((pid = fork()) == -1)
+		return -1;
+
+	if (pid == 0) {
+		if ((fd = open(stdout_path, O_WRONLY | O_CREAT | O_TRUNC, 0644)) == -1 || dup2(fd, STDOUT_FILENO) == -1)
+			_exit(127);
+		close(fd);
+		execv(args[0], args);
+		_exit(127);
+	}
+
+	while (wait4(pid, &status, 0, usage) == -1) {
+		if (errno != EINTR)
+			return -1;
+	}
+
+	return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+static long rss_kb(const struct rusage* usage) {
+#ifdef __APPLE__
+	return usage->ru_maxrss / 1024; /* bytes on macOS */
+#else
+	return usage->ru_maxrss;
+#endif
+}
+
+static int compare_doubles(const void* a, const void* b) {
+	double da = *(const double*)a;
+	double db = *(const double*)b;
+	return (da > db) - (da < db);
+}
+
+/* splits comma separated list in place */
+static size_t split_list(char* list, char** items, size_t max_items) {
+	size_t count = 0;
+	char* item;
+
+	for (item = strtok(list, ","); item != NULL && count < max_items; item = strtok(NULL, ","))
+		items[count++] = item;
+
+	return count;
+}
+
+static int benchmark(const char* generator, const char* sorter, char** extra_args, size_t num_extra_args, const char* dir, int keep, size_t repetitions, result_t* result) {
+	char corpus[4096], lines[32], seed[] = "1";
+	char* gen_args[] = { (char*)generator, "-n", lines, "-s", seed, "-O", (char*)result->order, "-o", corpus, NULL };
+	char* sort_args[MAX_EXTRA_ARGS + 3];
+	double* walls;
+	struct rusage usage;
+	struct stat st;
+	double start;
+	size_t i;
+	int ok = 0;
+
+	snprintf(lines, sizeof(lines), "%lu", (unsigned long)result->lines);
+	snprintf(corpus, sizeof(corpus), "%s/corpus-%s-%s.txt", dir, lines, result->order);
+
+	fprintf(stderr, "generating %s...\n", corpus);
+	if (run(gen_args, "/dev/null", &usage) != 0 || stat(corpus, &st) != 0) {
+		fprintf(stderr, "cannot generate %s\n", corpus);
+		return 0;
+	}
+	result->bytes = (unsigned long long)st.st_size;
+
+	sort_args[0] = (char*)sorter;
+	for (i = 0; i < num_extra_args; i++)
+		sort_args[i + 1] = extra_args[i];
+	sort_args[num_extra_args + 1] = corpus;
+	sort_args[num_extra_args + 2] = NULL;
+
+	if ((walls = malloc(repetitions * sizeof(double))) == NULL)
+		goto out;
+
+	result->peak_rss_kb = 0;
+	for (i = 0; i < repetitions; i++) {
+		fprintf(stderr, "sorting %s (%lu/%lu)...\n", corpus, (unsigned long)i + 1, (unsigned long)repetitions);
+		start = now_seconds();
+		if (run(sort_args, "/dev/null", &usage) != 0) {
+			fprintf(stderr, "version_sort failed on %s\n", corpus);
+			goto out;
+		}
+		walls[i] = now_seconds() - start;
+		if (rss_kb(&usage) > result->peak_rss_kb)
+			result->peak_rss_kb = rss_kb(&usage);
+	}
+
+	qsort(walls, repetitions, sizeof(double), compare_doubles);
+	result->wall = repetitions % 2 ? walls[repetitions / 2] : (walls[repetitions / 2 - 1] + walls[repetitions / 2]) / 2;
+	result->wall_min = walls[0];
+	ok = 1;
+
+out:
+	free(walls);
+	if (!keep)
+		unlink(corpus);
+	return ok;
+}
+
+static int write_json(const char* path, const result_t* results, size_t count) {
+	FILE* f;
+	size_t i;
+
+	if ((f = fopen(path, "w")) == NULL)
+		return 0;
+
+	fprintf(f, "{\n");
+	fprintf(f, "  \"library\": \"libversion\",\n");
+	fprintf(f, "  \"version\": \"%s\",\n", LIBVERSION_VERSION);
+	fprintf(f, "  \"benchmarks\": [\n");
+	for (i = 0; i < count; i++) {
+		const result_t* r = &results[i];
+		fprintf(f, "    {\n");
+		fprintf(f, "      \"name\": \"version_sort/%lu/%s\",\n", (unsigned long)r->lines, r->order);
+		fprintf(f, "      \"lines\": %lu,\n", (unsigned long)r->lines);
+		fprintf(f, "      \"bytes\": %llu,\n", r->bytes);
+		fprintf(f, "      \"wall_seconds\": { \"min\": %.3f, \"median\": %.3f },\n", r->wall_min, r->wall);
+		fprintf(f, "      \"lines_per_second\": %.0f,\n", (double)r->lines / r->wall);
+		fprintf(f, "      \"bytes_per_second\": %.0f,\n", (double)r->bytes / r->wall);
+		fprintf(f, "      \"peak_rss_kb\": %ld\n", r->peak_rss_kb);
+		fprintf(f, "    }%s\n", i + 1 < count ? "," : "");
+	}
+	fprintf(f, "  ]\n");
+	fprintf(f, "}\n");
+
+	return fclose(f) == 0;
+}
+
+static void print_usage(const char* progname) {
+	fprintf(stderr, "Usage: %s -g gen_corpus -s version_sort [-n sizes] [-O orders] [-r repetitions] [-d dir] [-k] [-x arg ...] [-o output.json]\n", progname);
+	fprintf(stderr, "\n");
+	fprintf(stderr, " -g path        - path to gen_corpus\n");
+	fprintf(stderr, " -s path        - path to version_sort\n");
+	fprintf(stderr, " -n sizes       - comma separated corpus sizes in lines (default 1000000,10000000,100000000)\n");
+	fprintf(stderr, " -O orders      - comma separated corpus orders (default random)\n");
+	fprintf(stderr, " -r repetitions - number of sort runs per corpus (default 1)\n");
+	fprintf(stderr, " -d dir         - directory for generated corpora (default .)\n");
+	fprintf(stderr, " -k             - keep generated corpora\n");
+	fprintf(stderr, " -x arg         - extra argument to pass to version_sort, may be repeated\n");
+	fprintf(stderr, " -o path        - write results as JSON\n");
+}
+
+int main(int argc, char** argv) {
+	const char* progname = argv[0];
+	const char *generator = NULL, *sorter = NULL, *dir = ".", *output = NULL;
+	char default_sizes[] = "1000000,10000000,100000000", default_orders[] = "random";
+	char *sizes_list = default_sizes, *orders_list = default_orders;
+	char* sizes[MAX_ITEMS];
+	char* orders[MAX_ITEMS];
+	char* extra_args[MAX_EXTRA_ARGS];
+	result_t results[MAX_ITEMS * MAX_ITEMS];
+	size_t num_sizes, num_orders, num_extra_args = 0, num_results = 0, repetitions = 1, isize, iorder;
+	int ch, keep = 0;
+
+	while ((ch = getopt(argc, argv, "g:s:n:O:r:d:kx:o:h")) != -1) {
+		switch (ch) {
+		case 'g': generator = optarg; break;
+		case 's': sorter = optarg; break;
+		case 'n': sizes_list = optarg; break;
+		case 'O': orders_list = optarg; break;
+		case 'r': repetitions = (size_t)strtoul(optarg, NULL, 10); break;
+		case 'd': dir = optarg; break;
+		case 'k': keep = 1; break;
+		case 'x':
+			if (num_extra_args == MAX_EXTRA_ARGS) {
+				fprintf(stderr, "too many extra arguments\n");
+				return 1;
+			}
+			extra_args[num_extra_args++] = optarg;
+			break;
+		case 'o': output = optarg; break;
+		case 'h':
+			print_usage(progname);
+			return 0;
+		default:
+			print_usage(progname);
+			return 1;
+		}
+	}
+
+	num_sizes = split_list(sizes_list, sizes, MAX_ITEMS);
+	num_orders = split_list(orders_list, orders, MAX_ITEMS);
+
+	if (generator == NULL || sorter == NULL || optind != argc || repetitions == 0 || num_sizes == 0 || num_orders == 0) {
+		print_usage(progname);
+		return 1;
+	}
+
+	printf("%-12s %-14s %10s %14s %10s %12s\n", "lines", "order", "wall, s", "lines/s", "MB/s", "peak RSS, MB");
+	fflush(stdout);
+
+	for (isize = 0; isize < num_sizes; isize++) {
+		for (iorder = 0; iorder < num_orders; iorder++) {
+			result_t* result = &results[num_results];
+			memset(result, 0, sizeof(result_t));
+			result->lines = (size_t)strtoull(sizes[isize], NULL, 10);
+			result->order = orders[iorder];
+
+			if (!benchmark(generator, sorter, extra_args, num_extra_args, dir, keep, repetitions, result))
+				return 1;
+
+			printf("%-12lu %-14s %10.3f %14.0f %10.1f %12.1f\n", (unsigned long)result->lines, result->order,
+				result->wall, (double)result->lines / result->wall, (double)result->bytes / result->wall / 1e6, (double)result->peak_rss_kb / 1024);
+			fflush(stdout);
+			num_results++;
+		}
+	}
+
+	if (output != NULL && !write_json(output, results, num_results)) {
+		fprintf(stderr, "cannot write %s\n", output);
+		return 1;
+	}
+
+	return 0;
+}
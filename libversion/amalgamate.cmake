@@ -0,0 +1,114 @@
+# Generates single header with whole comparison algorithm as static
+# inline functions from library sources
+#
+# Usage: cmake -DSOURCE_DIR=<libversion source dir> -DOUTPUT=<header> -P amalgamate.cmake
+
+set(INPUTS
+	private/string.h
+	private/component.h
+	private/keywords.h
+	private/parse.c
+	private/compare.c
+	compare.c
+)
+
+# internal identifiers which get prefixed to not clash with user code
+set(PRIVATE_NAMES
+	my_isalpha
+	my_isnumber
+	my_isseparator
+	my_tolower
+	my_memcasecmp
+	skip_alpha
+	skip_number
+	skip_zeroes
+	skip_separator
+	component_t
+	keyword_node_t
+	lookup_keyword
+	match_keyword
+	classify_keyword
+	parse_token_to_component
+	make_default_component
+	parse_next_component
+	get_next_version_component_ext
+	get_next_version_component
+	compare_components
+	next_component
+	compare_versions
+	is_over_limit
+)
+
+# public functions are renamed to not clash with library ones
+set(PUBLIC_NAMES
+	version_compare2
+	version_compare4
+	version_keywords_compare4
+	version_hardened_compare4
+)
+
+# functions which are not part of comparison algorithm
+set(SKIPPED_FUNCTIONS
+	version_sort_key
+	version_abbreviated_key
+	version_abbreviate_sort_key
+	version_keywords_sort_key
+	version_hardened_sort_key
+)
+
+set(IDENT_CHAR "A-Za-z0-9_")
+
+file(READ "${SOURCE_DIR}/../COPYING" LICENSE)
+string(REGEX REPLACE "\n+$" "" LICENSE "${LICENSE}")
+string(REPLACE "\n" "\n * " LICENSE "${LICENSE}")
+string(REPLACE " * \n" " *\n" LICENSE "${LICENSE}")
+
+set(RESULT "/*\n * ${LICENSE}\n */\n\n")
+string(APPEND RESULT "/* Generated from libversion sources by amalgamate.cmake, do not edit */\n\n")
+string(APPEND RESULT "#ifndef LIBVERSION_VERSION_INLINE_H\n#define LIBVERSION_VERSION_INLINE_H\n\n")
+string(APPEND RESULT "#include <stddef.h>\n#include <string.h>\n\n#include <libversion/version.h>\n#include <libversion/hardened.h>\n#include <libversion/keywords.h>\n")
+
+foreach(INPUT ${INPUTS})
+	file(READ "${SOURCE_DIR}/${INPUT}" CONTENT)
+
+	# license header, includes (all needed ones are above), include guards
+	string(REGEX REPLACE "^/\\*([^*]|\\*[^/])*\\*/\n" "" CONTENT "${CONTENT}")
+	string(REGEX REPLACE "#include <[^>]*>\n" "" CONTENT "${CONTENT}")
+	string(REGEX REPLACE "#(ifndef|define|endif /\\*) LIBVERSION_PRIVATE_[^\n]*\n" "" CONTENT "${CONTENT}")
+
+	# statistics hooks
+	string(REGEX REPLACE "\n#ifdef LIBVERSION_STATS\n[^#]*#endif\n" "\n" CONTENT "${CONTENT}")
+	string(REGEX REPLACE "{\n[\t ]*STATS_[^\n]*\n\n" "{\n" CONTENT "${CONTENT}")
+	string(REGEX REPLACE "\n[\t ]*STATS_[^\n]*" "" CONTENT "${CONTENT}")
+
+	foreach(FUNCTION ${SKIPPED_FUNCTIONS})
+		string(REGEX REPLACE "\n[^\n]* ${FUNCTION}\\([^\n]*\\) {\n([^}][^\n]*\n|\n)*}\n" "\n" CONTENT "${CONTENT}")
+	endforeach()
+
+	# every function becomes static inline
+	string(REGEX REPLACE "\nstatic ([a-z_]+[ *]+[a-z_0-9]+\\()" "\nLIBVERSION_INLINE_FUNCTION \\1" CONTENT "${CONTENT}")
+	string(REGEX REPLACE "\n([a-z_]+[ *]+[a-z_0-9]+\\([^\n;]*\\) {)" "\nLIBVERSION_INLINE_FUNCTION \\1" CONTENT "${CONTENT}")
+	string(REPLACE "LIBVERSION_INLINE_FUNCTION inline " "LIBVERSION_INLINE_FUNCTION " CONTENT "${CONTENT}")
+	string(REPLACE "LIBVERSION_INLINE_FUNCTION " "static inline " CONTENT "${CONTENT}")
+
+	# declarations are not needed as definitions come in order
+	string(REGEX REPLACE "\n[a-z_]+[ *]+[a-z_0-9]+\\([^\n{]*\\);\n" "\n" CONTENT "${CONTENT}")
+
+	foreach(NAME ${PRIVATE_NAMES})
+		string(REGEX REPLACE "([^${IDENT_CHAR}])${NAME}([^${IDENT_CHAR}])" "\\1libversion_inline_${NAME}\\2" CONTENT "${CONTENT}")
+	endforeach()
+	foreach(NAME ${PUBLIC_NAMES})
+		string(REGEX REPLACE "([^${IDENT_CHAR}])${NAME}([^${IDENT_CHAR}])" "\\1${NAME}_inline\\2" CONTENT "${CONTENT}")
+	endforeach()
+	string(REGEX REPLACE "([^${IDENT_CHAR}])(METAORDER_|KEYWORD_|MY_MIN)" "\\1LIBVERSION_INLINE_\\2" CONTENT "${CONTENT}")
+
+	string(REGEX REPLACE "\n\n\n+" "\n\n" CONTENT "${CONTENT}")
+	string(REGEX REPLACE "^\n+" "" CONTENT "${CONTENT}")
+	string(REGEX REPLACE "\n+$" "\n" CONTENT "${CONTENT}")
+
+	string(APPEND RESULT "\n/* ${INPUT} */\n${CONTENT}")
+endforeach()
+
+string(APPEND RESULT "\n#endif /* LIBVERSION_VERSION_INLINE_H */\n")
+
+file(WRITE "${OUTPUT}" "${RESULT}")
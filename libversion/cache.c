@@ -0,0 +1,407 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#include <libversion/cache.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <libversion/private/hash.h>
+#include <libversion/private/key.h>
+#include <libversion/private/mutex.h>
+#include <libversion/private/shared_cache.h>
+#include <libversion/version.h>
+
+/* Cache of comparable keys, split into independently locked shards
+ * by hash. Each shard is a chained hash table with entries also linked
+ * into a ring for CLOCK eviction. Memory used by entries and bucket
+ * arrays never exceeds shard's share of the limit. Keys are parsed
+ * and copied out of the cache without holding the lock.
+ *
+ * Alternatively, the cache may live in a region shared between
+ * processes, see private/shared_cache.c. */
+
+enum {
+	SHARD_BITS = 5,
+	NUM_SHARDS = 1 << SHARD_BITS,
+	INITIAL_BUCKETS = 64,
+};
+
+typedef struct cache_entry {
+	struct cache_entry* next;
+	struct cache_entry* clock_next;
+	struct cache_entry* clock_prev;
+	uint32_t hash;
+	size_t string_length;
+	size_t key_length;
+	int flags;
+	int referenced;
+	/* followed by string and key data */
+} cache_entry_t;
+
+typedef struct {
+	mutex_t mutex;
+	cache_entry_t** buckets;
+	size_t num_buckets;
+	size_t num_entries;
+	cache_entry_t* clock_hand;
+	size_t memory_usage;
+	size_t memory_limit;
+	size_t hits;
+	size_t misses;
+	size_t evictions;
+} cache_shard_t;
+
+struct version_cache {
+	cache_shard_t shards[NUM_SHARDS];
+	shared_cache_t* shared;
+};
+
+static const char* entry_string(const cache_entry_t* entry) {
+	return (const char*)(entry + 1);
+}
+
+static const unsigned char* entry_key(const cache_entry_t* entry) {
+	return (const unsigned char*)(entry + 1) + entry->string_length;
+}
+
+static size_t entry_size(const cache_entry_t* entry) {
+	return sizeof(cache_entry_t) + entry->string_length + entry->key_length;
+}
+
+static cache_shard_t* get_shard(version_cache_t* cache, uint32_t hash) {
+	return &cache->shards[hash >> (32 - SHARD_BITS)];
+}
+
+static cache_entry_t** get_bucket(cache_shard_t* shard, uint32_t hash) {
+	return &shard->buckets[hash & (shard->num_buckets - 1)];
+}
+
+static cache_entry_t* find_entry(cache_shard_t* shard, uint32_t hash, const char* v, size_t length, int flags) {
+	cache_entry_t* entry;
+
+	for (entry = *get_bucket(shard, hash); entry != NULL; entry = entry->next)
+		if (entry->hash == hash && entry->flags == flags && entry->string_length == length && memcmp(entry_string(entry), v, length) == 0)
+			return entry;
+
+	return NULL;
+}
+
+static void evict_entry(cache_shard_t* shard) {
+	cache_entry_t* victim;
+	cache_entry_t** link;
+
+	/* second chance for recently used entries */
+	while (shard->clock_hand->referenced) {
+		shard->clock_hand->referenced = 0;
+		shard->clock_hand = shard->clock_hand->clock_next;
+	}
+
+	victim = shard->clock_hand;
+
+	if (victim->clock_next == victim) {
+		shard->clock_hand = NULL;
+	} else {
+		victim->clock_prev->clock_next = victim->clock_next;
+		victim->clock_next->clock_prev = victim->clock_prev;
+		shard->clock_hand = victim->clock_next;
+	}
+
+	for (link = get_bucket(shard, victim->hash); *link != victim; link = &(*link)->next) {
+	}
+	*link = victim->next;
+
+	shard->memory_usage -= entry_size(victim);
+	shard->num_entries--;
+	shard->evictions++;
+
+	free(victim);
+}
+
+static void grow_buckets(cache_shard_t* shard) {
+	size_t num_buckets = shard->num_buckets * 2, i;
+	size_t extra_memory = (num_buckets - shard->num_buckets) * sizeof(cache_entry_t*);
+	cache_entry_t** buckets;
+	cache_entry_t* entry;
+
+	/* longer chains are better than evicting entries */
+	if (shard->memory_usage + extra_memory > shard->memory_limit)
+		return;
+
+	if ((buckets = calloc(num_buckets, sizeof(cache_entry_t*))) == NULL)
+		return;
+
+	for (i = 0; i < shard->num_buckets; i++) {
+		while ((entry = shard->buckets[i]) != NULL) {
+			shard->buckets[i] = entry->next;
+			entry->next = buckets[entry->hash & (num_buckets - 1)];
+			buckets[entry->hash & (num_buckets - 1)] = entry;
+		}
+	}
+
+	free(shard->buckets);
+	shard->buckets = buckets;
+	shard->num_buckets = num_buckets;
+	shard->memory_usage += extra_memory;
+}
+
+static void insert_entry(cache_shard_t* shard, cache_entry_t* entry) {
+	cache_entry_t** bucket;
+
+	while (shard->memory_usage + entry_size(entry) > shard->memory_limit && shard->clock_hand != NULL)
+		evict_entry(shard);
+
+	if (shard->memory_usage + entry_size(entry) > shard->memory_limit) {
+		free(entry);
+		return;
+	}
+
+	bucket = get_bucket(shard, entry->hash);
+	entry->next = *bucket;
+	*bucket = entry;
+
+	/* new entries are placed right behind the hand */
+	if (shard->clock_hand == NULL) {
+		entry->clock_next = entry->clock_prev = entry;
+		shard->clock_hand = entry;
+	} else {
+		entry->clock_next = shard->clock_hand;
+		entry->clock_prev = shard->clock_hand->clock_prev;
+		entry->clock_prev->clock_next = entry;
+		shard->clock_hand->clock_prev = entry;
+	}
+
+	shard->memory_usage += entry_size(entry);
+	shard->num_entries++;
+
+	if (shard->num_entries > shard->num_buckets)
+		grow_buckets(shard);
+}
+
+static int copy_key(key_buffer_t* key, const cache_entry_t* entry) {
+	key->data = key->inline_data;
+	key->length = entry->key_length;
+
+	if (key->length > sizeof(key->inline_data) && (key->data = malloc(key->length)) == NULL)
+		return 0;
+
+	memcpy(key->data, entry_key(entry), key->length);
+	return 1;
+}
+
+static int get_shared_key(version_cache_t* cache, const char* v, int flags, key_buffer_t* key) {
+	size_t length;
+	uint32_t hash = hash_version(v, flags, &length);
+	int res = shared_cache_lookup(cache->shared, hash, v, length, flags, key);
+
+	if (res != 0)
+		return res > 0;
+
+	if (!key_buffer_init(key, v, flags))
+		return 0;
+
+	shared_cache_insert(cache->shared, hash, v, length, flags, key);
+	return 1;
+}
+
+static int get_key(version_cache_t* cache, const char* v, int flags, key_buffer_t* key) {
+	size_t length;
+	uint32_t hash;
+	cache_shard_t* shard;
+	cache_entry_t* entry;
+	int res;
+
+	if (cache->shared != NULL)
+		return get_shared_key(cache, v, flags, key);
+
+	hash = hash_version(v, flags, &length);
+	shard = get_shard(cache, hash);
+
+	mutex_lock(&shard->mutex);
+	if ((entry = find_entry(shard, hash, v, length, flags)) != NULL) {
+		entry->referenced = 1;
+		shard->hits++;
+		res = copy_key(key, entry);
+		mutex_unlock(&shard->mutex);
+		return res;
+	}
+	shard->misses++;
+	mutex_unlock(&shard->mutex);
+
+	if (!key_buffer_init(key, v, flags))
+		return 0;
+
+	if (sizeof(cache_entry_t) + length + key->length > shard->memory_limit)
+		return 1;
+
+	if ((entry = malloc(sizeof(cache_entry_t) + length + key->length)) == NULL)
+		return 1;
+
+	entry->hash = hash;
+	entry->string_length = length;
+	entry->key_length = key->length;
+	entry->flags = flags;
+	entry->referenced = 0;
+	memcpy((char*)(entry + 1), v, length);
+	memcpy((unsigned char*)(entry + 1) + length, key->data, key->length);
+
+	mutex_lock(&shard->mutex);
+	if (find_entry(shard, hash, v, length, flags) != NULL)
+		free(entry); /* inserted by another thread meanwhile */
+	else
+		insert_entry(shard, entry);
+	mutex_unlock(&shard->mutex);
+
+	return 1;
+}
+
+version_cache_t* version_cache_create(size_t memory_limit) {
+	version_cache_t* cache;
+	cache_shard_t* shard;
+	size_t i;
+
+	/* every shard needs at least one bucket */
+	if (memory_limit < VERSIONCACHE_MIN_MEMORY_LIMIT)
+		memory_limit = VERSIONCACHE_MIN_MEMORY_LIMIT;
+
+	if ((cache = calloc(1, sizeof(version_cache_t))) == NULL)
+		return NULL;
+
+	for (i = 0; i < NUM_SHARDS; i++) {
+		shard = &cache->shards[i];
+		if (!mutex_init(&shard->mutex))
+			goto error;
+		shard->memory_limit = memory_limit / NUM_SHARDS;
+
+		/* small caches start with fewer buckets to leave room for entries */
+		shard->num_buckets = INITIAL_BUCKETS;
+		while (shard->num_buckets > 1 && shard->num_buckets * sizeof(cache_entry_t*) > shard->memory_limit / 4)
+			shard->num_buckets /= 2;
+
+		if ((shard->buckets = calloc(shard->num_buckets, sizeof(cache_entry_t*))) == NULL) {
+			mutex_destroy(&shard->mutex);
+			goto error;
+		}
+		shard->memory_usage = shard->num_buckets * sizeof(cache_entry_t*);
+	}
+
+	return cache;
+
+error:
+	for (; i > 0; i--) {
+		free(cache->shards[i - 1].buckets);
+		mutex_destroy(&cache->shards[i - 1].mutex);
+	}
+	free(cache);
+	return NULL;
+}
+
+version_cache_t* version_cache_create_shared(const char* path, size_t size) {
+	version_cache_t* cache;
+
+	if ((cache = calloc(1, sizeof(version_cache_t))) == NULL)
+		return NULL;
+
+	if ((cache->shared = shared_cache_open(path, size)) == NULL) {
+		free(cache);
+		return NULL;
+	}
+
+	return cache;
+}
+
+void version_cache_free(version_cache_t* cache) {
+	cache_entry_t* entry;
+	size_t i, j;
+
+	if (cache == NULL)
+		return;
+
+	if (cache->shared != NULL) {
+		shared_cache_close(cache->shared);
+		free(cache);
+		return;
+	}
+
+	for (i = 0; i < NUM_SHARDS; i++) {
+		for (j = 0; j < cache->shards[i].num_buckets; j++) {
+			while ((entry = cache->shards[i].buckets[j]) != NULL) {
+				cache->shards[i].buckets[j] = entry->next;
+				free(entry);
+			}
+		}
+		free(cache->shards[i].buckets);
+		mutex_destroy(&cache->shards[i].mutex);
+	}
+
+	free(cache);
+}
+
+int version_cache_compare4(version_cache_t* cache, const char* v1, const char* v2, int v1_flags, int v2_flags) {
+	key_buffer_t k1, k2;
+	int res;
+
+	/* allocation failures are not errors, just fall back to plain comparison */
+	if (!get_key(cache, v1, v1_flags, &k1))
+		return version_compare4(v1, v2, v1_flags, v2_flags);
+
+	if (!get_key(cache, v2, v2_flags, &k2)) {
+		key_buffer_free(&k1);
+		return version_compare4(v1, v2, v1_flags, v2_flags);
+	}
+
+	res = compare_version_keys(k1.data, k1.length, k2.data, k2.length);
+
+	key_buffer_free(&k1);
+	key_buffer_free(&k2);
+
+	return res;
+}
+
+int version_cache_compare2(version_cache_t* cache, const char* v1, const char* v2) {
+	return version_cache_compare4(cache, v1, v2, 0, 0);
+}
+
+void version_cache_get_stats(version_cache_t* cache, version_cache_stats_t* stats) {
+	cache_shard_t* shard;
+	size_t i;
+
+	memset(stats, 0, sizeof(version_cache_stats_t));
+
+	if (cache->shared != NULL) {
+		shared_cache_get_stats(cache->shared, stats);
+		return;
+	}
+
+	for (i = 0; i < NUM_SHARDS; i++) {
+		shard = &cache->shards[i];
+		mutex_lock(&shard->mutex);
+		stats->hits += shard->hits;
+		stats->misses += shard->misses;
+		stats->evictions += shard->evictions;
+		stats->entries += shard->num_entries;
+		stats->memory_usage += shard->memory_usage;
+		mutex_unlock(&shard->mutex);
+	}
+}
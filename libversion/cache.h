@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef LIBVERSION_CACHE_H
+#define LIBVERSION_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+
+#include <libversion/export.h>
+
+typedef struct version_cache version_cache_t;
+
+/* smaller memory limits are raised to this, which covers fixed per-shard overhead */
+enum {
+	VERSIONCACHE_MIN_MEMORY_LIMIT = 1024,
+};
+
+typedef struct {
+	size_t hits;
+	size_t misses;
+	size_t evictions;
+	size_t entries;
+	size_t memory_usage;
+} version_cache_stats_t;
+
+extern LIBVERSION_EXPORT version_cache_t* version_cache_create(size_t memory_limit);
+extern LIBVERSION_EXPORT version_cache_t* version_cache_create_shared(const char* path, size_t size);
+extern LIBVERSION_EXPORT void version_cache_free(version_cache_t* cache);
+
+extern LIBVERSION_EXPORT int version_cache_compare2(version_cache_t* cache, const char* v1, const char* v2);
+extern LIBVERSION_EXPORT int version_cache_compare4(version_cache_t* cache, const char* v1, const char* v2, int v1_flags, int v2_flags);
+
+extern LIBVERSION_EXPORT void version_cache_get_stats(version_cache_t* cache, version_cache_stats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBVERSION_CACHE_H */
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <libversion/version.h>
+#include <libversion/keywords.h>
+
+#include <libversion/private/parse.h>
+#include <libversion/private/string.h>
+
+static const int metaorder_classes[] = {
+	[METAORDER_LOWER_BOUND] = 0,
+	[METAORDER_PRE_RELEASE] = VERSIONCLASS_PRE_RELEASE,
+	[METAORDER_ZERO] = VERSIONCLASS_ZERO,
+	[METAORDER_POST_RELEASE] = VERSIONCLASS_POST_RELEASE,
+	[METAORDER_NONZERO] = VERSIONCLASS_NONZERO,
+	[METAORDER_LETTER_SUFFIX] = VERSIONCLASS_LETTER_SUFFIX,
+	[METAORDER_UPPER_BOUND] = 0,
+};
+
+static void classify(const char* v, int flags, const version_keywords_t* keywords, version_class_t* result) {
+	component_t components[2];
+	size_t len, i;
+	int unknown_keyword;
+
+	result->classes = 0;
+	result->components = 0;
+
+	/* padding components are not counted, so stop at trailing separators */
+	while (*(v = skip_separator(v)) != '\0') {
+		len = get_next_version_component_ext(&v, components, flags, keywords, &unknown_keyword);
+
+		for (i = 0; i < len; i++)
+			result->classes |= metaorder_classes[components[i].metaorder];
+		if (unknown_keyword)
+			result->classes |= VERSIONCLASS_UNKNOWN_KEYWORD;
+
+		result->components += len;
+	}
+}
+
+void version_classify(const char* v, int flags, version_class_t* result) {
+	classify(v, flags, NULL, result);
+}
+
+void version_keywords_classify(const version_keywords_t* keywords, const char* v, int flags, version_class_t* result) {
+	classify(v, flags, keywords, result);
+}
@@ -21,15 +21,48 @@
  */
 
 #include <libversion/version.h>
+#include <libversion/hardened.h>
+#include <libversion/keywords.h>
 
 #include <libversion/private/parse.h>
 #include <libversion/private/compare.h>
+#include <libversion/private/key.h>
+#include <libversion/private/stats.h>
+
+#include <string.h>
 
 #define MY_MIN(a, b) ((a) < (b) ? (a) : (b))
 
-int version_compare4(const char* v1, const char* v2, int v1_flags, int v2_flags) {
+static inline size_t next_component(const char** str, component_t* component, int flags, const version_keywords_t* keywords, size_t max_components, size_t* count) {
+	size_t len;
+	int unknown_keyword;
+
+	/* components past the limit are ignored, as if the version ended there */
+	if (max_components != 0 && *count >= max_components) {
+		*str = "";
+		return get_next_version_component(str, component, flags);
+	}
+
+	/* built-in keywords are matched without lookups */
+	if (keywords == NULL)
+		len = get_next_version_component(str, component, flags);
+	else
+		len = get_next_version_component_ext(str, component, flags, keywords, &unknown_keyword);
+
+	if (max_components != 0 && (*count += len) > max_components) {
+		/* letter suffix crossing the limit */
+		len -= *count - max_components;
+		*count = max_components;
+		*str = "";
+	}
+
+	return len;
+}
+
+static inline int compare_versions(const char* v1, const char* v2, int v1_flags, int v2_flags, const version_keywords_t* keywords, size_t max_components) {
 	component_t v1_components[2], v2_components[2];
 	size_t v1_len = 0, v2_len = 0;
+	size_t v1_count = 0, v2_count = 0;
 	size_t shift, i;
 
 	int v1_extra_components = (v1_flags & (VERSIONFLAG_LOWER_BOUND|VERSIONFLAG_UPPER_BOUND)) ? 1 : 0;
@@ -39,19 +72,31 @@ int version_compare4(const char* v1, const char* v2, int v1_flags, int v2_flags)
 
 	int res;
 
+#ifdef LIBVERSION_STATS
+	size_t depth = 0;
+#endif
+
+	STATS_INC(STAT_COMPARE_CALLS);
+
 	do {
 		if (v1_len == 0)
-			v1_len = get_next_version_component(&v1, v1_components, v1_flags);
+			v1_len = next_component(&v1, v1_components, v1_flags, keywords, max_components, &v1_count);
 		if (v2_len == 0)
-			v2_len = get_next_version_component(&v2, v2_components, v2_flags);
+			v2_len = next_component(&v2, v2_components, v2_flags, keywords, max_components, &v2_count);
 
 		shift = MY_MIN(v1_len, v2_len);
 		for (i = 0; i < shift; i++) {
 			res = compare_components(&v1_components[i], &v2_components[i]);
-			if (res != 0)
+			if (res != 0) {
+				STATS_DECIDED_AT(depth + i);
 				return res;
+			}
 		}
 
+#ifdef LIBVERSION_STATS
+		depth += shift;
+#endif
+
 		if (v1_len != v2_len) {
 			for (i = 0; i < shift; i++) {
 				v1_components[i] = v1_components[i+shift];
@@ -75,9 +120,83 @@ int version_compare4(const char* v1, const char* v2, int v1_flags, int v2_flags)
 		}
 	} while (!v1_exhausted || !v2_exhausted);
 
+	STATS_INC(STAT_EQUAL_RESULTS);
 	return 0;
 }
 
+int version_compare4(const char* v1, const char* v2, int v1_flags, int v2_flags) {
+	return compare_versions(v1, v2, v1_flags, v2_flags, NULL, 0);
+}
+
+int version_keywords_compare4(const version_keywords_t* keywords, const char* v1, const char* v2, int v1_flags, int v2_flags) {
+	return compare_versions(v1, v2, v1_flags, v2_flags, keywords, 0);
+}
+
+/* does not look further than max_bytes + 1 bytes */
+static inline int is_over_limit(const char* v, size_t max_bytes) {
+	size_t len = 0;
+
+	if (max_bytes == 0)
+		return 0;
+
+	while (len < max_bytes && v[len] != '\0')
+		len++;
+
+	return v[len] != '\0';
+}
+
+int version_hardened_compare4(const version_limits_t* limits, const char* v1, const char* v2, int v1_flags, int v2_flags) {
+	int v1_over_limit = is_over_limit(v1, limits->max_bytes);
+	int v2_over_limit = is_over_limit(v2, limits->max_bytes);
+	int res;
+
+	/* over limit versions come before all others, and are ordered
+	 * bytewise by their first max_bytes bytes */
+	if (v1_over_limit || v2_over_limit) {
+		if (!v2_over_limit)
+			return -1;
+		if (!v1_over_limit)
+			return 1;
+
+		res = memcmp(v1, v2, limits->max_bytes);
+		return (res > 0) - (res < 0);
+	}
+
+	return compare_versions(v1, v2, v1_flags, v2_flags, NULL, limits->max_components);
+}
+
 int version_compare2(const char* v1, const char* v2) {
 	return version_compare4(v1, v2, 0, 0);
 }
+
+size_t version_sort_key(const char* v, int flags, unsigned char* buf, size_t size) {
+	return make_version_key(v, flags, buf, size);
+}
+
+uint64_t version_abbreviated_key(const char* v, int flags) {
+	return make_abbreviated_version_key(v, flags);
+}
+
+uint64_t version_abbreviate_sort_key(const unsigned char* key, size_t length) {
+	return abbreviate_version_key(key, length);
+}
+
+size_t version_keywords_sort_key(const version_keywords_t* keywords, const char* v, int flags, unsigned char* buf, size_t size) {
+	return make_version_key_keywords(v, flags, keywords, buf, size);
+}
+
+size_t version_hardened_sort_key(const version_limits_t* limits, const char* v, int flags, unsigned char* buf, size_t size) {
+	if (is_over_limit(v, limits->max_bytes)) {
+		if (size > 0) {
+			buf[0] = KEY_OVER_LIMIT;
+			memcpy(buf + 1, v, MY_MIN(limits->max_bytes, size - 1));
+		}
+		return 1 + limits->max_bytes;
+	}
+
+	if (size == 0)
+		return 1 + make_version_key_limited(v, flags, limits->max_components, buf, 0);
+
+	buf[0] = KEY_WITHIN_LIMIT;
+	return 1 + make_version_key_limited(v, flags, limits->max_components, buf + 1, size - 1);
+}
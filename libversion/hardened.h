@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef LIBVERSION_HARDENED_H
+#define LIBVERSION_HARDENED_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+
+#include <libversion/export.h>
+
+typedef struct {
+	size_t max_bytes;      /* longer versions are over limit; 0 means unlimited */
+	size_t max_components; /* further components are ignored; 0 means unlimited */
+} version_limits_t;
+
+/* same as functions from version.h, but with work bounded by limits */
+extern LIBVERSION_EXPORT int version_hardened_compare4(const version_limits_t* limits, const char* v1, const char* v2, int v1_flags, int v2_flags);
+extern LIBVERSION_EXPORT size_t version_hardened_sort_key(const version_limits_t* limits, const char* v, int flags, unsigned char* buf, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBVERSION_HARDENED_H */
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <libversion/keywords.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <libversion/private/keywords.h>
+#include <libversion/private/string.h>
+
+/* same as hardcoded in parse.c, except for flag dependent 'p' */
+static const version_keyword_t default_keywords[] = {
+	{ "alpha", VERSIONKEYWORD_EXACT, VERSIONKEYWORD_PRE_RELEASE },
+	{ "beta", VERSIONKEYWORD_EXACT, VERSIONKEYWORD_PRE_RELEASE },
+	{ "rc", VERSIONKEYWORD_EXACT, VERSIONKEYWORD_PRE_RELEASE },
+	{ "pre", VERSIONKEYWORD_PREFIX, VERSIONKEYWORD_PRE_RELEASE },
+	{ "post", VERSIONKEYWORD_PREFIX, VERSIONKEYWORD_POST_RELEASE },
+	{ "patch", VERSIONKEYWORD_PREFIX, VERSIONKEYWORD_POST_RELEASE },
+	{ "pl", VERSIONKEYWORD_EXACT, VERSIONKEYWORD_POST_RELEASE },
+	{ "errata", VERSIONKEYWORD_EXACT, VERSIONKEYWORD_POST_RELEASE },
+};
+
+#define COUNT(a) (sizeof(a)/sizeof(a[0]))
+
+static int is_valid_rule(const version_keyword_t* rule) {
+	const char* cur;
+
+	if (rule->keyword == NULL || *rule->keyword == '\0')
+		return 0;
+	for (cur = rule->keyword; *cur != '\0'; ++cur)
+		if (!my_isalpha(*cur))
+			return 0;
+
+	return (rule->match == VERSIONKEYWORD_EXACT || rule->match == VERSIONKEYWORD_PREFIX) &&
+		(rule->rank == VERSIONKEYWORD_PRE_RELEASE || rule->rank == VERSIONKEYWORD_POST_RELEASE || rule->rank == VERSIONKEYWORD_RELEASE);
+}
+
+static size_t count_nodes(const version_keyword_t* rules, size_t count) {
+	size_t total = 0, i;
+	for (i = 0; i < count; i++)
+		total += strlen(rules[i].keyword);
+	return total;
+}
+
+static void insert_rule(version_keywords_t* keywords, const version_keyword_t* rule, int ordinal) {
+	keyword_node_t* node = keywords->nodes;
+	unsigned char* slot;
+	unsigned char* slot_ordinal;
+	const char* cur;
+	int letter;
+
+	for (cur = rule->keyword; *cur != '\0'; ++cur) {
+		letter = my_tolower(*cur) - 'a';
+		if (node->children[letter] == 0)
+			node->children[letter] = (unsigned int)keywords->num_nodes++;
+		node = &keywords->nodes[node->children[letter]];
+	}
+
+	/* earlier rules take priority */
+	slot = rule->match == VERSIONKEYWORD_PREFIX ? &node->prefix : &node->exact;
+	slot_ordinal = rule->match == VERSIONKEYWORD_PREFIX ? &node->prefix_ordinal : &node->exact_ordinal;
+	if (*slot == KEYWORD_UNKNOWN) {
+		*slot = (unsigned char)rule->rank;
+		*slot_ordinal = (unsigned char)ordinal;
+	}
+}
+
+version_keywords_t* version_keywords_build(const version_keyword_t* rules, size_t count, int options) {
+	version_keywords_t* keywords;
+	size_t capacity = 1, i;
+	int ordinals[KEYWORD_RELEASE + 1] = { 0 };
+
+	for (i = 0; i < count; i++) {
+		if (!is_valid_rule(&rules[i]))
+			return NULL;
+		if (rules[i].rank != VERSIONKEYWORD_RELEASE && ++ordinals[rules[i].rank] > VERSIONKEYWORDS_MAX_RANKED)
+			return NULL;
+	}
+
+	capacity += count_nodes(rules, count);
+	if (options & VERSIONKEYWORDS_DEFAULT)
+		capacity += count_nodes(default_keywords, COUNT(default_keywords));
+
+	if ((keywords = malloc(sizeof(version_keywords_t))) == NULL)
+		return NULL;
+	if ((keywords->nodes = calloc(capacity, sizeof(keyword_node_t))) == NULL) {
+		free(keywords);
+		return NULL;
+	}
+	keywords->num_nodes = 1;
+
+	/* given rules are ordered as listed, release ones need no order */
+	memset(ordinals, 0, sizeof(ordinals));
+	for (i = 0; i < count; i++)
+		insert_rule(keywords, &rules[i], rules[i].rank == VERSIONKEYWORD_RELEASE ? 0 : ++ordinals[rules[i].rank]);
+
+	/* built-in ones are ordered by first letter, as without profile */
+	if (options & VERSIONKEYWORDS_DEFAULT)
+		for (i = 0; i < COUNT(default_keywords); i++)
+			insert_rule(keywords, &default_keywords[i], 0);
+
+	return keywords;
+}
+
+void version_keywords_free(version_keywords_t* keywords) {
+	if (keywords == NULL)
+		return;
+	free(keywords->nodes);
+	free(keywords);
+}
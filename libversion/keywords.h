@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef LIBVERSION_KEYWORDS_H
+#define LIBVERSION_KEYWORDS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+
+#include <libversion/export.h>
+#include <libversion/version.h>
+
+/* how keyword rule matches alphabetic component */
+enum {
+	VERSIONKEYWORD_EXACT,
+	VERSIONKEYWORD_PREFIX,
+};
+
+/* what matched component is treated as */
+enum {
+	VERSIONKEYWORD_PRE_RELEASE = 1,
+	VERSIONKEYWORD_POST_RELEASE = 2,
+	VERSIONKEYWORD_RELEASE = 3, /* same as zero, e.g. 1.0final == 1.0 */
+};
+
+/* build options */
+enum {
+	VERSIONKEYWORDS_DEFAULT = 0x1, /* also include built-in keywords, with lower priority */
+};
+
+/* maximal number of pre-release and of post-release rules in a profile */
+enum {
+	VERSIONKEYWORDS_MAX_RANKED = 32,
+};
+
+typedef struct {
+	const char* keyword; /* letters only, case insensitive */
+	int match;
+	int rank;
+} version_keyword_t;
+
+typedef struct version_keywords version_keywords_t;
+
+extern LIBVERSION_EXPORT version_keywords_t* version_keywords_build(const version_keyword_t* rules, size_t count, int options);
+extern LIBVERSION_EXPORT void version_keywords_free(version_keywords_t* keywords);
+
+/* same as functions from version.h; NULL keywords means built-in ones */
+extern LIBVERSION_EXPORT int version_keywords_compare4(const version_keywords_t* keywords, const char* v1, const char* v2, int v1_flags, int v2_flags);
+extern LIBVERSION_EXPORT size_t version_keywords_sort_key(const version_keywords_t* keywords, const char* v, int flags, unsigned char* buf, size_t size);
+extern LIBVERSION_EXPORT void version_keywords_classify(const version_keywords_t* keywords, const char* v, int flags, version_class_t* result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBVERSION_KEYWORDS_H */
@@ -54,6 +54,20 @@ int compare_components(const component_t* u1, const component_t* u2) {
 	int u2_is_alpha = my_isalpha(*u2->start);
 
 	if (u1_is_alpha && u2_is_alpha) {
+		/* keywords ranked by profile come first, in order of their rules */
+		if (u1->ordinal != u2->ordinal) {
+			if (u1->ordinal == 0) {
+				return 1;
+			}
+			if (u2->ordinal == 0) {
+				return -1;
+			}
+			return u1->ordinal < u2->ordinal ? -1 : 1;
+		}
+		if (u1->ordinal != 0) {
+			return 0;
+		}
+
 		if (my_tolower(*u1->start) < my_tolower(*u2->start)) {
 			return -1;
 		}
@@ -37,6 +37,10 @@ typedef struct {
 	int metaorder;
 	const char* start;
 	const char* end;
+	/* for alphabetic components matched by keyword profile rule, its
+	 * position (starting with 1) among rules of the same rank; these
+	 * come first, and the rest (0) is ordered by first letter */
+	int ordinal;
 } component_t;
 
 #endif /* LIBVERSION_PRIVATE_COMPONENT_H */
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef LIBVERSION_PRIVATE_HASH_H
+#define LIBVERSION_PRIVATE_HASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* 32 bit FNV-1a of a version string and its flags; also returns
+ * string length. Multiplication is done in 64 bits and truncated,
+ * so it does not rely on unsigned wraparound */
+static inline uint32_t hash_version(const char* v, int flags, size_t* length) {
+	uint64_t hash = 0x811c9dc5;
+	const char* cur;
+
+	for (cur = v; *cur != '\0'; cur++)
+		hash = ((hash ^ (unsigned char)*cur) * 0x01000193) & 0xffffffff;
+
+	hash = ((hash ^ ((unsigned)flags & 0xff)) * 0x01000193) & 0xffffffff;
+
+	*length = cur - v;
+	return (uint32_t)hash;
+}
+
+#endif /* LIBVERSION_PRIVATE_HASH_H */
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef LIBVERSION_PRIVATE_INDEX_FORMAT_H
+#define LIBVERSION_PRIVATE_INDEX_FORMAT_H
+
+#include <stdint.h>
+
+/* Index file consists of a header, a table of count + 1 entry offsets
+ * (relative to the start of data area), and the data area, where each
+ * entry is a comparable key followed by the original version string,
+ * both NUL terminated (keys never contain zero bytes).
+ * Entries are sorted by key, then by string. Integers are stored in
+ * native byte order, which is checked with byte_order field. */
+
+#define INDEX_MAGIC "LVINDEX"
+
+enum {
+	INDEX_FORMAT = 2, /* also bumped when key encoding changes */
+	INDEX_BYTE_ORDER = 0x01020304,
+};
+
+typedef struct {
+	char magic[8];
+	uint32_t format;
+	uint32_t byte_order;
+	uint32_t flags; /* flags versions were parsed with */
+	uint32_t reserved;
+	uint64_t count;
+	uint64_t offsets_offset;
+	uint64_t data_offset;
+	uint64_t data_size;
+} index_header_t;
+
+#endif /* LIBVERSION_PRIVATE_INDEX_FORMAT_H */
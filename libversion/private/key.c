@@ -0,0 +1,379 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <libversion/private/key.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <libversion/private/parse.h>
+#include <libversion/private/stats.h>
+#include <libversion/private/string.h>
+#include <libversion/version.h>
+
+#define MY_MIN(a, b) ((a) < (b) ? (a) : (b))
+
+typedef struct {
+	unsigned char* buf;
+	size_t size;
+	size_t length;
+} key_writer_t;
+
+static void put_byte(key_writer_t* writer, unsigned char byte) {
+	if (writer->length < writer->size)
+		writer->buf[writer->length] = byte;
+	writer->length++;
+}
+
+static void put_bytes(key_writer_t* writer, const char* start, const char* end) {
+	size_t len = end - start;
+	if (writer->length < writer->size)
+		memcpy(writer->buf + writer->length, start, MY_MIN(len, writer->size - writer->length));
+	writer->length += len;
+}
+
+static void put_zeroes(key_writer_t* writer, size_t count, unsigned char code) {
+	for (; count > 0; count--)
+		put_byte(writer, code);
+}
+
+static void put_component(key_writer_t* writer, const component_t* component) {
+	size_t len = component->end - component->start;
+
+	switch (component->metaorder) {
+	case METAORDER_PRE_RELEASE:
+		if (component->ordinal != 0)
+			put_byte(writer, KEY_PRE_RELEASE_RANKED + (component->ordinal - 1));
+		else
+			put_byte(writer, KEY_PRE_RELEASE + (my_tolower(*component->start) - 'a'));
+		break;
+	case METAORDER_POST_RELEASE:
+		if (component->ordinal != 0)
+			put_byte(writer, KEY_POST_RELEASE_RANKED + (component->ordinal - 1));
+		else
+			put_byte(writer, KEY_POST_RELEASE + (my_tolower(*component->start) - 'a'));
+		break;
+	case METAORDER_LETTER_SUFFIX:
+		put_byte(writer, KEY_LETTER_SUFFIX + (my_tolower(*component->start) - 'a'));
+		break;
+	case METAORDER_NONZERO:
+		if (len <= KEY_SHORT_NUMBER_MAX) {
+			put_byte(writer, KEY_NONZERO + (len - 1));
+		} else {
+			/* longer numbers are greater: run of 0xff, then remainder */
+			len -= KEY_SHORT_NUMBER_MAX + 1;
+			put_byte(writer, KEY_LONG_NONZERO);
+			for (; len >= KEY_LONG_NUMBER_STEP; len -= KEY_LONG_NUMBER_STEP)
+				put_byte(writer, 0xff);
+			put_byte(writer, len + 1);
+		}
+		put_bytes(writer, component->start, component->end);
+		break;
+	}
+}
+
+/* with stop_when_full, parsing stops once size bytes are written, and
+ * the returned length is only meaningful up to size */
+static inline size_t make_key(const char* v, int flags, const version_keywords_t* keywords, size_t max_components, int stop_when_full, unsigned char* buf, size_t size) {
+	key_writer_t writer = { buf, size, 0 };
+	component_t components[2];
+	size_t pending_zeroes = 0, count = 0;
+	size_t len, i;
+	int unknown_keyword;
+
+	/* truncated keys are counted as abbreviated ones */
+	if (!stop_when_full)
+		STATS_INC(STAT_KEY_CALLS);
+
+	while (*skip_separator(v) != '\0' && (max_components == 0 || count < max_components) && !(stop_when_full && writer.length >= size)) {
+		if (keywords == NULL)
+			len = get_next_version_component(&v, components, flags);
+		else
+			len = get_next_version_component_ext(&v, components, flags, keywords, &unknown_keyword);
+
+		/* components past the limit are ignored */
+		if (max_components != 0 && len > max_components - count)
+			len = max_components - count;
+		count += len;
+
+		for (i = 0; i < len; i++) {
+			if (components[i].metaorder == METAORDER_ZERO) {
+				/* zero component code depends on what follows the run of zeroes */
+				pending_zeroes++;
+				continue;
+			}
+
+			put_zeroes(&writer, pending_zeroes, components[i].metaorder < METAORDER_ZERO ? KEY_ZERO_BEFORE_LOWER : KEY_ZERO_BEFORE_HIGHER);
+			pending_zeroes = 0;
+
+			put_component(&writer, &components[i]);
+		}
+	}
+
+	/* trailing padding, same as make_default_component() would produce */
+	if (flags & VERSIONFLAG_LOWER_BOUND) {
+		put_zeroes(&writer, pending_zeroes, KEY_ZERO_BEFORE_LOWER);
+		put_byte(&writer, KEY_LOWER_BOUND);
+	} else if (flags & VERSIONFLAG_UPPER_BOUND) {
+		put_zeroes(&writer, pending_zeroes, KEY_ZERO_BEFORE_HIGHER);
+		put_byte(&writer, KEY_UPPER_BOUND);
+	} else {
+		put_byte(&writer, KEY_END);
+	}
+
+	return writer.length;
+}
+
+size_t make_version_key(const char* v, int flags, unsigned char* buf, size_t size) {
+	return make_key(v, flags, NULL, 0, 0, buf, size);
+}
+
+size_t make_version_key_keywords(const char* v, int flags, const version_keywords_t* keywords, unsigned char* buf, size_t size) {
+	return make_key(v, flags, keywords, 0, 0, buf, size);
+}
+
+size_t make_version_key_limited(const char* v, int flags, size_t max_components, unsigned char* buf, size_t size) {
+	return make_key(v, flags, NULL, max_components, 0, buf, size);
+}
+
+/* value is cut to its high bits if it doesn't fit, which keeps the order */
+static void put_bits(uint64_t* abbreviated, unsigned* used, unsigned value, unsigned width) {
+	if (width > 64 - *used) {
+		value >>= width - (64 - *used);
+		width = 64 - *used;
+	}
+	*used += width;
+	*abbreviated |= (uint64_t)value << (64 - *used);
+}
+
+uint64_t abbreviate_version_key(const unsigned char* key, size_t key_len) {
+	const unsigned char* end = key + key_len;
+	uint64_t abbreviated = 0;
+	unsigned used = 0;
+	unsigned char code;
+	size_t digits;
+
+	STATS_INC(STAT_ABBREVIATED_KEY_CALLS);
+
+	while (key < end && used < 64) {
+		code = *key++;
+		put_bits(&abbreviated, &used, code, 8);
+
+		if (code >= KEY_NONZERO && code < KEY_LONG_NONZERO) {
+			digits = code - KEY_NONZERO + 1;
+		} else if (code == KEY_LONG_NONZERO) {
+			for (digits = KEY_SHORT_NUMBER_MAX + 1; key < end && *key == 0xff && used < 64; key++) {
+				put_bits(&abbreviated, &used, 0xff, 8);
+				digits += KEY_LONG_NUMBER_STEP;
+			}
+			if (key == end || used == 64)
+				break;
+			put_bits(&abbreviated, &used, *key, 8);
+			digits += *key++ - 1;
+		} else {
+			continue;
+		}
+
+		/* decimal digits only need 4 bits */
+		for (; digits > 0 && key < end && used < 64; digits--)
+			put_bits(&abbreviated, &used, *key++ - '0', 4);
+	}
+
+	return abbreviated;
+}
+
+uint64_t make_abbreviated_version_key(const char* v, int flags) {
+	unsigned char buf[KEY_ABBREVIATION_INPUT];
+	size_t length = make_key(v, flags, NULL, 0, 1, buf, sizeof(buf));
+	return abbreviate_version_key(buf, MY_MIN(length, sizeof(buf)));
+}
+
+int compare_version_keys(const unsigned char* k1, size_t k1_len, const unsigned char* k2, size_t k2_len) {
+	int res;
+
+	STATS_INC(STAT_KEY_COMPARE_CALLS);
+
+	res = memcmp(k1, k2, MY_MIN(k1_len, k2_len));
+	if (res < 0)
+		return -1;
+	if (res > 0)
+		return 1;
+	if (k1_len < k2_len)
+		return -1;
+	if (k1_len > k2_len)
+		return 1;
+	return 0;
+}
+
+size_t get_key_token_length(const unsigned char* key) {
+	size_t pos = 1, digits;
+
+	if (key[0] >= KEY_NONZERO && key[0] < KEY_LONG_NONZERO)
+		return 1 + (key[0] - KEY_NONZERO + 1);
+
+	if (key[0] != KEY_LONG_NONZERO)
+		return 1;
+
+	for (digits = KEY_SHORT_NUMBER_MAX + 1; key[pos] == 0xff; pos++)
+		digits += KEY_LONG_NUMBER_STEP;
+	digits += key[pos++] - 1;
+
+	return pos + digits;
+}
+
+static void put_char(char* buf, size_t size, size_t* length, char c) {
+	if (*length < size)
+		buf[*length] = c;
+	(*length)++;
+}
+
+static void put_string(char* buf, size_t size, size_t* length, const char* str, size_t len) {
+	for (; len > 0; len--)
+		put_char(buf, size, length, *str++);
+}
+
+size_t make_version_from_key(const unsigned char* key, size_t key_len, char* buf, size_t size) {
+	/* keywords which produce the same rank as the letter they start with */
+	static const char* pre_release_keywords[26] = { ['a' - 'a'] = "alpha", ['b' - 'a'] = "beta", ['p' - 'a'] = "pre", ['r' - 'a'] = "rc" };
+	static const char* post_release_keywords[26] = { ['e' - 'a'] = "errata", ['p' - 'a'] = "patch" };
+
+	const unsigned char* end = key + key_len;
+	const char* keyword;
+	size_t length = 0, token_length;
+	unsigned char code;
+
+	while (key < end && !is_key_end(*key)) {
+		code = *key;
+		token_length = get_key_token_length(key);
+
+		if (length > 0 && !(code >= KEY_LETTER_SUFFIX && code < KEY_LETTER_SUFFIX + 26))
+			put_char(buf, size, &length, '.');
+
+		if (code >= KEY_PRE_RELEASE && code < KEY_PRE_RELEASE + 26) {
+			keyword = pre_release_keywords[code - KEY_PRE_RELEASE];
+			if (keyword != NULL)
+				put_string(buf, size, &length, keyword, strlen(keyword));
+			else
+				put_char(buf, size, &length, 'a' + (code - KEY_PRE_RELEASE));
+		} else if (code >= KEY_POST_RELEASE && code < KEY_POST_RELEASE + 26) {
+			keyword = post_release_keywords[code - KEY_POST_RELEASE];
+			if (keyword != NULL)
+				put_string(buf, size, &length, keyword, strlen(keyword));
+			else
+				put_char(buf, size, &length, 'a' + (code - KEY_POST_RELEASE));
+		} else if (code >= KEY_LETTER_SUFFIX && code < KEY_LETTER_SUFFIX + 26) {
+			put_char(buf, size, &length, 'a' + (code - KEY_LETTER_SUFFIX));
+			/* lone p would be a keyword with VERSIONFLAG_P_IS_PATCH */
+			if (code == KEY_LETTER_SUFFIX + ('p' - 'a'))
+				put_char(buf, size, &length, 'x');
+		} else if (code == KEY_ZERO_BEFORE_LOWER || code == KEY_ZERO_BEFORE_HIGHER) {
+			put_char(buf, size, &length, '0');
+		} else {
+			/* number digits follow the code and, for long numbers, the length */
+			const unsigned char* digits = key + 1;
+			if (code == KEY_LONG_NONZERO) {
+				while (*digits == 0xff)
+					digits++;
+				digits++;
+			}
+			put_string(buf, size, &length, (const char*)digits, key + token_length - digits);
+		}
+
+		key += token_length;
+	}
+
+	if (size > 0)
+		buf[length < size ? length : size - 1] = '\0';
+
+	return length;
+}
+
+int key_buffer_init(key_buffer_t* key, const char* v, int flags) {
+	key->data = key->inline_data;
+	key->length = make_version_key(v, flags, key->data, sizeof(key->inline_data));
+
+	if (key->length > sizeof(key->inline_data)) {
+		if ((key->data = malloc(key->length)) == NULL)
+			return 0;
+		make_version_key(v, flags, key->data, key->length);
+	}
+
+	return 1;
+}
+
+void key_buffer_free(key_buffer_t* key) {
+	if (key->data != key->inline_data)
+		free(key->data);
+}
+
+static int key_arena_reserve(key_arena_t* arena, size_t length) {
+	size_t capacity = arena->capacity ? arena->capacity : 256;
+	unsigned char* data;
+
+	if (arena->capacity - arena->size >= length)
+		return 1;
+
+	while (capacity - arena->size < length)
+		capacity *= 2;
+
+	if ((data = realloc(arena->data, capacity)) == NULL)
+		return 0;
+
+	arena->data = data;
+	arena->capacity = capacity;
+	return 1;
+}
+
+int key_arena_append(key_arena_t* arena, const char* v, int flags, size_t* offset, size_t* length) {
+	if (!key_arena_reserve(arena, 1))
+		return 0;
+
+	*length = make_version_key(v, flags, arena->data + arena->size, arena->capacity - arena->size);
+
+	if (*length > arena->capacity - arena->size) {
+		if (!key_arena_reserve(arena, *length))
+			return 0;
+		make_version_key(v, flags, arena->data + arena->size, *length);
+	}
+
+	*offset = arena->size;
+	arena->size += *length;
+	return 1;
+}
+
+int key_arena_append_bytes(key_arena_t* arena, const void* data, size_t length, size_t* offset) {
+	if (!key_arena_reserve(arena, length))
+		return 0;
+
+	if (length > 0)
+		memcpy(arena->data + arena->size, data, length);
+
+	*offset = arena->size;
+	arena->size += length;
+	return 1;
+}
+
+void key_arena_free(key_arena_t* arena) {
+	free(arena->data);
+	arena->data = NULL;
+	arena->size = arena->capacity = 0;
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef LIBVERSION_PRIVATE_KEY_H
+#define LIBVERSION_PRIVATE_KEY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <libversion/keywords.h>
+
+/* Keys are byte strings which, compared with compare_version_keys(),
+ * order exactly like version_compare4() orders the versions they were
+ * made from. Keys never contain zero bytes and no key is a prefix of
+ * another one. See doc/ALGORITHM.md for the encoding. */
+
+enum {
+	KEY_INLINE_SIZE = 128,
+	KEY_INFINITY = 0xff, /* single byte key greater than any version */
+};
+
+/* key bytes enough for an abbreviated key, as each byte takes at least 4 bits of it */
+enum {
+	KEY_ABBREVIATION_INPUT = 16,
+};
+
+enum {
+	KEY_SHORT_NUMBER_MAX = 16,
+	KEY_LONG_NUMBER_STEP = 0xfe,
+};
+
+/* byte values of component codes, in ascending order */
+enum {
+	KEY_LOWER_BOUND = 0x01,
+	KEY_PRE_RELEASE_RANKED = 0x02, /* + ordinal - 1, for keywords ranked by profile */
+	KEY_PRE_RELEASE = KEY_PRE_RELEASE_RANKED + VERSIONKEYWORDS_MAX_RANKED, /* + letter, 26 codes */
+	KEY_ZERO_BEFORE_LOWER = KEY_PRE_RELEASE + 26,
+	KEY_END = KEY_ZERO_BEFORE_LOWER + 1,
+	KEY_ZERO_BEFORE_HIGHER = KEY_END + 1,
+	KEY_POST_RELEASE_RANKED = KEY_ZERO_BEFORE_HIGHER + 1, /* + ordinal - 1 */
+	KEY_POST_RELEASE = KEY_POST_RELEASE_RANKED + VERSIONKEYWORDS_MAX_RANKED, /* + letter, 26 codes */
+	KEY_NONZERO = KEY_POST_RELEASE + 26, /* + length - 1, for short numbers */
+	KEY_LONG_NONZERO = KEY_NONZERO + KEY_SHORT_NUMBER_MAX,
+	KEY_LETTER_SUFFIX = KEY_LONG_NONZERO + 1, /* + letter, 26 codes */
+	KEY_UPPER_BOUND = KEY_LETTER_SUFFIX + 26,
+};
+
+/* first byte of keys produced by version_hardened_sort_key() */
+enum {
+	KEY_OVER_LIMIT = 0x01,   /* followed by max_bytes first bytes of the version */
+	KEY_WITHIN_LIMIT = 0x02, /* followed by ordinary key */
+};
+
+static inline int is_key_end(unsigned char code) {
+	return code == KEY_END || code == KEY_LOWER_BOUND || code == KEY_UPPER_BOUND;
+}
+
+typedef struct {
+	unsigned char* data;
+	size_t length;
+	unsigned char inline_data[KEY_INLINE_SIZE];
+} key_buffer_t;
+
+typedef struct {
+	unsigned char* data;
+	size_t size;
+	size_t capacity;
+} key_arena_t;
+
+size_t make_version_key(const char* v, int flags, unsigned char* buf, size_t size);
+size_t make_version_key_keywords(const char* v, int flags, const version_keywords_t* keywords, unsigned char* buf, size_t size);
+size_t make_version_key_limited(const char* v, int flags, size_t max_components, unsigned char* buf, size_t size);
+
+int compare_version_keys(const unsigned char* k1, size_t k1_len, const unsigned char* k2, size_t k2_len);
+
+/* first 64 bits of the key, with number digits packed into 4 bits each;
+ * abbreviated keys order the same way as full keys when they differ */
+uint64_t abbreviate_version_key(const unsigned char* key, size_t key_len);
+uint64_t make_abbreviated_version_key(const char* v, int flags);
+
+/* length of the component code (with number digits) at the start of the key */
+size_t get_key_token_length(const unsigned char* key);
+
+/* canonical version string which produces the same key, returns length as snprintf;
+ * keywords ranked by a profile can't be restored and are left out */
+size_t make_version_from_key(const unsigned char* key, size_t key_len, char* buf, size_t size);
+
+/* key of a single version, stored inline if it fits */
+int key_buffer_init(key_buffer_t* key, const char* v, int flags);
+void key_buffer_free(key_buffer_t* key);
+
+/* growing storage for many keys, addressed by offsets */
+int key_arena_append(key_arena_t* arena, const char* v, int flags, size_t* offset, size_t* length);
+int key_arena_append_bytes(key_arena_t* arena, const void* data, size_t length, size_t* offset);
+void key_arena_free(key_arena_t* arena);
+
+#endif /* LIBVERSION_PRIVATE_KEY_H */
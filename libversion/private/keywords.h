@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef LIBVERSION_PRIVATE_KEYWORDS_H
+#define LIBVERSION_PRIVATE_KEYWORDS_H
+
+#include <stddef.h>
+
+#include <libversion/keywords.h>
+#include <libversion/private/string.h>
+
+/* same values as VERSIONKEYWORD_* ranks */
+enum {
+	KEYWORD_UNKNOWN,
+	KEYWORD_PRE_RELEASE,
+	KEYWORD_POST_RELEASE,
+	KEYWORD_RELEASE,
+};
+
+/* Keywords are compiled into a trie over lowercase letters, with the
+ * root at index 0 (so 0 child means no child) */
+typedef struct {
+	unsigned int children[26];
+	unsigned char exact;  /* KEYWORD_* of exact rule for this node */
+	unsigned char prefix; /* KEYWORD_* of prefix rule for this node */
+	unsigned char exact_ordinal;  /* see component_t */
+	unsigned char prefix_ordinal;
+} keyword_node_t;
+
+struct version_keywords {
+	keyword_node_t* nodes;
+	size_t num_nodes;
+};
+
+/* Finds rank and ordinal for alphabetic token: exact rule wins, then
+ * the longest prefix rule */
+static inline int lookup_keyword(const version_keywords_t* keywords, const char* start, const char* end, int* ordinal) {
+	const keyword_node_t* node = keywords->nodes;
+	const keyword_node_t* prefix = NULL;
+	unsigned int child;
+
+	for (; start != end; ++start) {
+		if (node->prefix != KEYWORD_UNKNOWN)
+			prefix = node;
+		if ((child = node->children[my_tolower(*start) - 'a']) == 0)
+			break;
+		node = &keywords->nodes[child];
+	}
+
+	if (start == end) {
+		if (node->exact != KEYWORD_UNKNOWN) {
+			*ordinal = node->exact_ordinal;
+			return node->exact;
+		}
+		if (node->prefix != KEYWORD_UNKNOWN)
+			prefix = node;
+	}
+
+	if (prefix != NULL) {
+		*ordinal = prefix->prefix_ordinal;
+		return prefix->prefix;
+	}
+
+	*ordinal = 0;
+	return KEYWORD_UNKNOWN;
+}
+
+#endif /* LIBVERSION_PRIVATE_KEYWORDS_H */
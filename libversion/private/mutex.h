@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef LIBVERSION_PRIVATE_MUTEX_H
+#define LIBVERSION_PRIVATE_MUTEX_H
+
+#ifdef _WIN32
+#include <windows.h>
+
+typedef SRWLOCK mutex_t;
+
+#define MUTEX_INITIALIZER SRWLOCK_INIT
+
+static inline int mutex_init(mutex_t* mutex) {
+	InitializeSRWLock(mutex);
+	return 1;
+}
+
+static inline void mutex_destroy(mutex_t* mutex) {
+	(void)mutex;
+}
+
+static inline void mutex_lock(mutex_t* mutex) {
+	AcquireSRWLockExclusive(mutex);
+}
+
+static inline void mutex_unlock(mutex_t* mutex) {
+	ReleaseSRWLockExclusive(mutex);
+}
+#else
+#include <pthread.h>
+
+typedef pthread_mutex_t mutex_t;
+
+#define MUTEX_INITIALIZER PTHREAD_MUTEX_INITIALIZER
+
+static inline int mutex_init(mutex_t* mutex) {
+	return pthread_mutex_init(mutex, NULL) == 0;
+}
+
+static inline void mutex_destroy(mutex_t* mutex) {
+	pthread_mutex_destroy(mutex);
+}
+
+static inline void mutex_lock(mutex_t* mutex) {
+	pthread_mutex_lock(mutex);
+}
+
+static inline void mutex_unlock(mutex_t* mutex) {
+	pthread_mutex_unlock(mutex);
+}
+#endif
+
+#endif /* LIBVERSION_PRIVATE_MUTEX_H */
@@ -22,16 +22,12 @@
 
 #include <libversion/private/parse.h>
 
+#include <libversion/private/keywords.h>
+#include <libversion/private/stats.h>
 #include <libversion/private/string.h>
 #include <libversion/version.h>
 
-enum {
-	KEYWORD_UNKNOWN,
-	KEYWORD_PRE_RELEASE,
-	KEYWORD_POST_RELEASE,
-};
-
-static int classify_keyword(const char* start, const char* end, int flags) {
+static int match_keyword(const char* start, const char* end, int flags) {
 	if (end - start == 5 && my_memcasecmp(start, "alpha", 5) == 0)
 		return KEYWORD_PRE_RELEASE;
 	else if (end - start == 4 && my_memcasecmp(start, "beta", 4) == 0)
@@ -54,21 +50,42 @@ static int classify_keyword(const char* start, const char* end, int flags) {
 	return KEYWORD_UNKNOWN;
 }
 
-static void parse_token_to_component(const char** str, component_t* component, int flags) {
+static int classify_keyword(const char* start, const char* end, int flags, const version_keywords_t* keywords, int* ordinal) {
+	int keyword;
+
+	if (keywords == NULL) {
+		keyword = match_keyword(start, end, flags);
+		*ordinal = 0;
+	} else {
+		keyword = lookup_keyword(keywords, start, end, ordinal);
+		if (keyword == KEYWORD_UNKNOWN && flags & VERSIONFLAG_P_IS_PATCH && end - start == 1 && (*start == 'p' || *start == 'P'))
+			keyword = KEYWORD_POST_RELEASE;
+	}
+
+	STATS_INC(STAT_KEYWORDS_UNKNOWN + keyword); /* same order as KEYWORD_* */
+	return keyword;
+}
+
+/* returns whether the token is alphabetic and not a known keyword */
+static int parse_token_to_component(const char** str, component_t* component, int flags, const version_keywords_t* keywords) {
 	if (my_isalpha(**str)) {
 		component->start = *str;
 		component->end = *str = skip_alpha(*str);
 
-		switch (classify_keyword(component->start, component->end, flags)) {
+		switch (classify_keyword(component->start, component->end, flags, keywords, &component->ordinal)) {
 		case KEYWORD_UNKNOWN:
 			component->metaorder = (flags & VERSIONFLAG_ANY_IS_PATCH) ? METAORDER_POST_RELEASE : METAORDER_PRE_RELEASE;
-			break;
+			return 1;
 		case KEYWORD_PRE_RELEASE:
 			component->metaorder = METAORDER_PRE_RELEASE;
 			break;
 		case KEYWORD_POST_RELEASE:
 			component->metaorder = METAORDER_POST_RELEASE;
 			break;
+		case KEYWORD_RELEASE:
+			component->metaorder = METAORDER_ZERO;
+			component->start = component->end;
+			break;
 		}
 	} else {
 		component->start = *str = skip_zeroes(*str);
@@ -80,11 +97,15 @@ static void parse_token_to_component(const char** str, component_t* component, i
 			component->metaorder = METAORDER_NONZERO;
 		}
 	}
+
+	return 0;
 }
 
 static void make_default_component(component_t* component, int flags) {
 	static const char* empty = "";
 
+	STATS_INC(STAT_PADDING_COMPONENTS);
+
 	if (flags & VERSIONFLAG_LOWER_BOUND) {
 		component->metaorder = METAORDER_LOWER_BOUND;
 	} else if (flags & VERSIONFLAG_UPPER_BOUND) {
@@ -96,15 +117,16 @@ static void make_default_component(component_t* component, int flags) {
 	component->end = empty;
 }
 
-size_t get_next_version_component(const char** str, component_t* component, int flags) {
+static inline size_t parse_next_component(const char** str, component_t* component, int flags, const version_keywords_t* keywords, int* unknown_keyword) {
 	*str = skip_separator(*str);
 
 	if (**str == '\0') {
 		make_default_component(component, flags);
+		*unknown_keyword = 0;
 		return 1;
 	}
 
-	parse_token_to_component(str, component, flags);
+	*unknown_keyword = parse_token_to_component(str, component, flags, keywords);
 
 	/* Special case for letter suffix:
 	 * - We taste whether the next component is alpha not followed by a number,
@@ -113,13 +135,17 @@ size_t get_next_version_component(const char** str, component_t* component, int
 	 * - Otherwise, it's treated as letter suffix
 	 */
 	if (my_isalpha(**str)) {
+		STATS_INC(STAT_LETTER_SUFFIX_LOOKAHEADS);
+
 		++component;
 
 		component->start = *str;
 		component->end = skip_alpha(*str);
 
 		if (!my_isnumber(*component->end)) {
-			switch (classify_keyword(component->start, component->end, flags)) {
+			*str = component->end;
+
+			switch (classify_keyword(component->start, component->end, flags, keywords, &component->ordinal)) {
 			case KEYWORD_UNKNOWN:
 				component->metaorder = METAORDER_LETTER_SUFFIX;
 				break;
@@ -129,12 +155,26 @@ size_t get_next_version_component(const char** str, component_t* component, int
 			case KEYWORD_POST_RELEASE:
 				component->metaorder = METAORDER_POST_RELEASE;
 				break;
+			case KEYWORD_RELEASE:
+				component->metaorder = METAORDER_ZERO;
+				component->start = component->end;
+				break;
 			}
 
-			*str = component->end;
+			STATS_ADD(STAT_COMPONENTS_PARSED, 2);
 			return 2;
 		}
 	}
 
+	STATS_INC(STAT_COMPONENTS_PARSED);
 	return 1;
 }
+
+size_t get_next_version_component(const char** str, component_t* component, int flags) {
+	int unknown_keyword;
+	return parse_next_component(str, component, flags, NULL, &unknown_keyword);
+}
+
+size_t get_next_version_component_ext(const char** str, component_t* component, int flags, const version_keywords_t* keywords, int* unknown_keyword) {
+	return parse_next_component(str, component, flags, keywords, unknown_keyword);
+}
@@ -25,8 +25,14 @@
 
 #include <stddef.h>
 
+#include <libversion/keywords.h>
 #include <libversion/private/component.h>
 
 size_t get_next_version_component(const char** str, component_t* component, int flags);
 
+/* same as above, with given keywords (NULL means built-in ones); also
+ * reports whether the first returned component is an alphabetic token
+ * which is not a known keyword */
+size_t get_next_version_component_ext(const char** str, component_t* component, int flags, const version_keywords_t* keywords, int* unknown_keyword);
+
 #endif /* LIBVERSION_PRIVATE_PARSE_H */
@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef LIBVERSION_PRIVATE_RANDOM_H
+#define LIBVERSION_PRIVATE_RANDOM_H
+
+#include <stdint.h>
+
+/* xorshift64 for deterministic test and benchmark inputs (state must
+ * not be zero); shifted values are masked so no bits are shifted out */
+static inline uint64_t next_random(uint64_t* state) {
+	uint64_t x = *state;
+	x ^= (x & (UINT64_MAX >> 13)) << 13;
+	x ^= x >> 7;
+	x ^= (x & (UINT64_MAX >> 17)) << 17;
+	return *state = x;
+}
+
+#endif /* LIBVERSION_PRIVATE_RANDOM_H */
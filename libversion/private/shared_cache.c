@@ -0,0 +1,379 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <libversion/private/shared_cache.h>
+
+#ifndef _WIN32
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* Region shared between processes, which may be mapped at different
+ * addresses, so it only contains offsets. It starts with a header,
+ * followed by an open addressing table of slots and an append-only
+ * area for entries. Writers allocate entries by atomically bumping
+ * the area pointer, fill them, and then publish them by CAS-ing an
+ * empty slot; readers never wait. Entries are never removed, once
+ * the region is full new versions are just not cached. A process
+ * dying in the middle of insertion can only waste some space. */
+
+#define SHARED_CACHE_MAGIC 0x4353564cu /* "LVSC" */
+
+enum {
+	SHARED_CACHE_FORMAT = 2, /* also bumped when key encoding changes */
+	ENTRY_ALIGNMENT = 8,
+	BYTES_PER_SLOT = 64,
+	MIN_SIZE = 4096,
+};
+
+/* slot holds hash in high half and offset / ENTRY_ALIGNMENT in low one */
+#define MAX_SIZE ((uint64_t)UINT32_MAX * ENTRY_ALIGNMENT)
+
+typedef struct {
+	uint32_t magic;
+	uint32_t format;
+	uint64_t size;
+	uint64_t num_slots;
+	uint64_t data_offset;
+	_Atomic uint64_t used;
+	_Atomic uint64_t entries;
+} shared_header_t;
+
+typedef struct {
+	uint32_t string_length;
+	uint32_t key_length;
+	int32_t flags;
+	uint32_t reserved;
+	/* followed by string and key data */
+} shared_entry_t;
+
+struct shared_cache {
+	unsigned char* base;
+	size_t size;
+	/* local to the process to avoid contention */
+	_Atomic size_t hits;
+	_Atomic size_t misses;
+};
+
+static shared_header_t* get_header(const shared_cache_t* cache) {
+	return (shared_header_t*)cache->base;
+}
+
+static _Atomic uint64_t* get_slots(const shared_cache_t* cache) {
+	return (_Atomic uint64_t*)(cache->base + sizeof(shared_header_t));
+}
+
+/* the region may come from a file anyone could have written, so entries
+ * are checked to lie within it; fields are copied out, as they're only
+ * valid as checked */
+static const shared_entry_t* get_entry(const shared_cache_t* cache, uint64_t slot, shared_entry_t* fields) {
+	uint64_t offset = (slot & 0xffffffff) * ENTRY_ALIGNMENT;
+	const shared_entry_t* entry;
+
+	if (offset < get_header(cache)->data_offset || offset > cache->size - sizeof(shared_entry_t))
+		return NULL;
+
+	entry = (const shared_entry_t*)(cache->base + offset);
+	memcpy(fields, entry, sizeof(shared_entry_t));
+
+	if ((uint64_t)fields->string_length + fields->key_length > cache->size - offset - sizeof(shared_entry_t))
+		return NULL;
+
+	return entry;
+}
+
+static int entry_matches(const shared_entry_t* entry, const shared_entry_t* fields, const char* v, size_t length, int flags) {
+	return entry != NULL && fields->flags == flags && fields->string_length == length && memcmp(entry + 1, v, length) == 0;
+}
+
+static void init_region(unsigned char* base, uint64_t size) {
+	shared_header_t* header = (shared_header_t*)base;
+	uint64_t num_slots = 1;
+
+	while (num_slots * 2 <= size / BYTES_PER_SLOT)
+		num_slots *= 2;
+
+	header->size = size;
+	header->num_slots = num_slots;
+	header->data_offset = sizeof(shared_header_t) + num_slots * sizeof(uint64_t);
+	atomic_init(&header->used, header->data_offset);
+	atomic_init(&header->entries, 0);
+	header->format = SHARED_CACHE_FORMAT;
+	header->magic = SHARED_CACHE_MAGIC;
+}
+
+static int check_region(const unsigned char* base, size_t size) {
+	const shared_header_t* header = (const shared_header_t*)base;
+
+	return size >= sizeof(shared_header_t) &&
+		header->magic == SHARED_CACHE_MAGIC &&
+		header->format == SHARED_CACHE_FORMAT &&
+		header->size == size &&
+		header->num_slots != 0 &&
+		(header->num_slots & (header->num_slots - 1)) == 0 &&
+		header->num_slots <= size / sizeof(uint64_t) &&
+		header->data_offset == sizeof(shared_header_t) + header->num_slots * sizeof(uint64_t) &&
+		header->data_offset <= size;
+}
+
+static unsigned char* map_region(int fd, size_t size) {
+	void* base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	return base == MAP_FAILED ? NULL : (unsigned char*)base;
+}
+
+static unsigned char* attach_file(const char* path, size_t* size) {
+	struct stat st;
+	unsigned char* base = NULL;
+	int fd;
+
+	if ((fd = open(path, O_RDWR)) == -1)
+		return NULL;
+
+	if (fstat(fd, &st) == 0 && st.st_size > 0 && (uint64_t)st.st_size <= MAX_SIZE) {
+		*size = (size_t)st.st_size;
+		if ((base = map_region(fd, *size)) != NULL && !check_region(base, *size)) {
+			munmap(base, *size);
+			base = NULL;
+		}
+	}
+
+	close(fd);
+	return base;
+}
+
+/* the file is initialized under a temporary name and then linked into
+ * place, so other processes never see it half-initialized */
+static unsigned char* create_file(const char* path, size_t size) {
+	char* temp_path;
+	unsigned char* base = NULL;
+	int fd, saved_errno = 0;
+
+	if ((temp_path = malloc(strlen(path) + 8)) == NULL)
+		return NULL;
+	sprintf(temp_path, "%s.XXXXXX", path);
+
+	if ((fd = mkstemp(temp_path)) == -1) {
+		free(temp_path);
+		return NULL;
+	}
+
+	if (ftruncate(fd, (off_t)size) == 0 && (base = map_region(fd, size)) != NULL) {
+		init_region(base, size);
+		if (link(temp_path, path) != 0) {
+			saved_errno = errno;
+			munmap(base, size);
+			base = NULL;
+		}
+	}
+
+	close(fd);
+	unlink(temp_path);
+	free(temp_path);
+	errno = saved_errno;
+	return base;
+}
+
+shared_cache_t* shared_cache_open(const char* path, size_t size) {
+	shared_cache_t* cache;
+
+	if (size < MIN_SIZE)
+		size = MIN_SIZE;
+	if (size > MAX_SIZE)
+		size = (size_t)MAX_SIZE;
+	size -= size % ENTRY_ALIGNMENT;
+
+	if ((cache = malloc(sizeof(shared_cache_t))) == NULL)
+		return NULL;
+
+	cache->size = size;
+	atomic_init(&cache->hits, 0);
+	atomic_init(&cache->misses, 0);
+
+	if (path == NULL) {
+		/* anonymous mapping is shared with processes forked afterwards */
+		void* base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+		if (base == MAP_FAILED)
+			goto error;
+		cache->base = (unsigned char*)base;
+		init_region(cache->base, size);
+		return cache;
+	}
+
+	/* existing file is reused as is, regardless of requested size */
+	if ((cache->base = attach_file(path, &cache->size)) != NULL)
+		return cache;
+
+	if (errno == ENOENT) {
+		if ((cache->base = create_file(path, size)) != NULL)
+			return cache;
+		/* lost the race to another process */
+		if (errno == EEXIST && (cache->base = attach_file(path, &cache->size)) != NULL)
+			return cache;
+	}
+
+error:
+	free(cache);
+	return NULL;
+}
+
+void shared_cache_close(shared_cache_t* cache) {
+	if (cache == NULL)
+		return;
+
+	munmap(cache->base, cache->size);
+	free(cache);
+}
+
+int shared_cache_lookup(shared_cache_t* cache, uint32_t hash, const char* v, size_t length, int flags, key_buffer_t* key) {
+	const shared_header_t* header = get_header(cache);
+	_Atomic uint64_t* slots = get_slots(cache);
+	uint64_t mask = header->num_slots - 1, i, slot;
+	const shared_entry_t* entry;
+	shared_entry_t fields;
+
+	for (i = 0; i <= mask; i++) {
+		slot = atomic_load_explicit(&slots[(hash + i) & mask], memory_order_acquire);
+		if (slot == 0)
+			break;
+		if ((slot >> 32) != hash)
+			continue;
+
+		/* entries which fail the checks are not matched */
+		entry = get_entry(cache, slot, &fields);
+		if (entry_matches(entry, &fields, v, length, flags)) {
+			atomic_fetch_add_explicit(&cache->hits, 1, memory_order_relaxed);
+			key->data = key->inline_data;
+			key->length = fields.key_length;
+			if (key->length > sizeof(key->inline_data) && (key->data = malloc(key->length)) == NULL)
+				return -1;
+			memcpy(key->data, (const unsigned char*)(entry + 1) + fields.string_length, key->length);
+			return 1;
+		}
+	}
+
+	atomic_fetch_add_explicit(&cache->misses, 1, memory_order_relaxed);
+	return 0;
+}
+
+void shared_cache_insert(shared_cache_t* cache, uint32_t hash, const char* v, size_t length, int flags, const key_buffer_t* key) {
+	shared_header_t* header = get_header(cache);
+	_Atomic uint64_t* slots = get_slots(cache);
+	uint64_t mask = header->num_slots - 1, i, offset, slot, expected;
+	uint64_t entry_size = sizeof(shared_entry_t) + length + key->length;
+	shared_entry_t* entry;
+	shared_entry_t fields;
+
+	entry_size += (ENTRY_ALIGNMENT - entry_size % ENTRY_ALIGNMENT) % ENTRY_ALIGNMENT;
+
+	if (entry_size > cache->size)
+		return;
+
+	/* keep the table sparse enough for probing to stay short */
+	if (atomic_load_explicit(&header->entries, memory_order_relaxed) >= header->num_slots / 4 * 3)
+		return;
+
+	/* check first, so the pointer never goes far beyond the end */
+	if (atomic_load_explicit(&header->used, memory_order_relaxed) + entry_size > cache->size)
+		return;
+
+	offset = atomic_fetch_add_explicit(&header->used, entry_size, memory_order_relaxed);
+	if (offset < header->data_offset || offset + entry_size > cache->size)
+		return;
+
+	entry = (shared_entry_t*)(cache->base + offset);
+	entry->string_length = (uint32_t)length;
+	entry->key_length = (uint32_t)key->length;
+	entry->flags = flags;
+	entry->reserved = 0;
+	memcpy(entry + 1, v, length);
+	memcpy((unsigned char*)(entry + 1) + length, key->data, key->length);
+
+	slot = ((uint64_t)hash << 32) | (offset / ENTRY_ALIGNMENT);
+
+	for (i = 0; i <= mask; i++) {
+		expected = 0;
+		if (atomic_compare_exchange_strong_explicit(&slots[(hash + i) & mask], &expected, slot, memory_order_release, memory_order_acquire)) {
+			atomic_fetch_add_explicit(&header->entries, 1, memory_order_relaxed);
+			return;
+		}
+
+		/* inserted by another process meanwhile */
+		if ((expected >> 32) == hash && entry_matches(get_entry(cache, expected, &fields), &fields, v, length, flags))
+			return;
+	}
+}
+
+void shared_cache_get_stats(const shared_cache_t* cache, version_cache_stats_t* stats) {
+	const shared_header_t* header = get_header(cache);
+	uint64_t used = atomic_load_explicit(&header->used, memory_order_relaxed);
+
+	stats->hits = atomic_load_explicit(&cache->hits, memory_order_relaxed);
+	stats->misses = atomic_load_explicit(&cache->misses, memory_order_relaxed);
+	stats->evictions = 0;
+	stats->entries = (size_t)atomic_load_explicit(&header->entries, memory_order_relaxed);
+	stats->memory_usage = used < cache->size ? (size_t)used : cache->size;
+}
+
+#else
+
+shared_cache_t* shared_cache_open(const char* path, size_t size) {
+	(void)path;
+	(void)size;
+	return NULL;
+}
+
+void shared_cache_close(shared_cache_t* cache) {
+	(void)cache;
+}
+
+int shared_cache_lookup(shared_cache_t* cache, uint32_t hash, const char* v, size_t length, int flags, key_buffer_t* key) {
+	(void)cache;
+	(void)hash;
+	(void)v;
+	(void)length;
+	(void)flags;
+	(void)key;
+	return 0;
+}
+
+void shared_cache_insert(shared_cache_t* cache, uint32_t hash, const char* v, size_t length, int flags, const key_buffer_t* key) {
+	(void)cache;
+	(void)hash;
+	(void)v;
+	(void)length;
+	(void)flags;
+	(void)key;
+}
+
+void shared_cache_get_stats(const shared_cache_t* cache, version_cache_stats_t* stats) {
+	(void)cache;
+	(void)stats;
+}
+
+#endif
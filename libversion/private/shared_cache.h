@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef LIBVERSION_PRIVATE_SHARED_CACHE_H
+#define LIBVERSION_PRIVATE_SHARED_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <libversion/cache.h>
+#include <libversion/private/key.h>
+
+typedef struct shared_cache shared_cache_t;
+
+shared_cache_t* shared_cache_open(const char* path, size_t size);
+void shared_cache_close(shared_cache_t* cache);
+
+/* returns 1 if found, 0 if not found, -1 on allocation failure */
+int shared_cache_lookup(shared_cache_t* cache, uint32_t hash, const char* v, size_t length, int flags, key_buffer_t* key);
+void shared_cache_insert(shared_cache_t* cache, uint32_t hash, const char* v, size_t length, int flags, const key_buffer_t* key);
+
+/* hits and misses are counted per process */
+void shared_cache_get_stats(const shared_cache_t* cache, version_cache_stats_t* stats);
+
+#endif /* LIBVERSION_PRIVATE_SHARED_CACHE_H */
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef LIBVERSION_PRIVATE_STATS_H
+#define LIBVERSION_PRIVATE_STATS_H
+
+#include <libversion/config.h>
+
+#ifdef LIBVERSION_STATS
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <libversion/stats.h>
+
+/* same order as fields of version_stats_t */
+enum {
+	STAT_COMPARE_CALLS,
+	STAT_COMPONENTS_PARSED,
+	STAT_PADDING_COMPONENTS,
+	STAT_LETTER_SUFFIX_LOOKAHEADS,
+	STAT_KEYWORDS_UNKNOWN,
+	STAT_KEYWORDS_PRE_RELEASE,
+	STAT_KEYWORDS_POST_RELEASE,
+	STAT_KEYWORDS_RELEASE,
+	STAT_EQUAL_RESULTS,
+	STAT_DECIDED_AT,
+	STAT_KEY_CALLS = STAT_DECIDED_AT + VERSION_STATS_DECISION_DEPTH,
+	STAT_ABBREVIATED_KEY_CALLS,
+	STAT_KEY_COMPARE_CALLS,
+	STAT_COUNT
+};
+
+/* Counters of a single thread. These are only written by the owning
+ * thread, so increments need no atomic read-modify-write; atomics are
+ * only used so snapshots from other threads are not data races. For
+ * the same reason, a reset racing with an increment may be lost. */
+typedef struct stats_block {
+	_Atomic uint64_t counters[STAT_COUNT];
+	struct stats_block* next;
+} stats_block_t;
+
+#ifdef _MSC_VER
+#	define STATS_THREAD_LOCAL __declspec(thread)
+#else
+#	define STATS_THREAD_LOCAL _Thread_local
+#endif
+
+extern STATS_THREAD_LOCAL stats_block_t* stats_current_block;
+
+stats_block_t* stats_register_block(void);
+
+static inline void stats_add(int counter, uint64_t value) {
+	stats_block_t* block = stats_current_block;
+
+	if (block == NULL && (block = stats_register_block()) == NULL)
+		return;
+
+	atomic_store_explicit(&block->counters[counter], atomic_load_explicit(&block->counters[counter], memory_order_relaxed) + value, memory_order_relaxed);
+}
+
+#	define STATS_ADD(counter, value) stats_add((counter), (value))
+#	define STATS_DECIDED_AT(depth) stats_add(STAT_DECIDED_AT + ((depth) < VERSION_STATS_DECISION_DEPTH ? (int)(depth) : VERSION_STATS_DECISION_DEPTH - 1), 1)
+#else
+#	define STATS_ADD(counter, value) ((void)0)
+#	define STATS_DECIDED_AT(depth) ((void)0)
+#endif
+
+#define STATS_INC(counter) STATS_ADD(counter, 1)
+
+#endif /* LIBVERSION_PRIVATE_STATS_H */
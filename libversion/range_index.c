@@ -0,0 +1,305 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <libversion/range_index.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <libversion/private/key.h>
+
+/* Centered interval tree. Exclusivity is folded into endpoints, which
+ * are placed just below or just above their key, so all ranges become
+ * closed intervals and queried versions never equal an exclusive
+ * endpoint. Each node has a center endpoint (median of endpoints in its
+ * subtree), keeps ranges which contain it sorted both by lower and by
+ * upper endpoint, and passes ranges completely below or above it to its
+ * children. Query walks a single path of O(log n) nodes and scans only
+ * ranges which match, plus one which stops the scan per node, which
+ * gives O(log n + k) stabbing queries. Empty ranges are dropped. */
+
+#define NO_NODE ((size_t)-1)
+
+typedef struct {
+	const unsigned char* key;
+	size_t length;
+	int side; /* -1 just below key, 0 at key, 1 just above key */
+} endpoint_t;
+
+typedef struct {
+	endpoint_t lower;
+	endpoint_t upper;
+	size_t id;
+} range_entry_t;
+
+typedef struct {
+	endpoint_t center;
+	size_t offset; /* of node ranges in both by_lower and by_upper */
+	size_t count;
+	size_t left;
+	size_t right;
+} range_node_t;
+
+struct version_range_index {
+	range_entry_t* by_lower;
+	range_entry_t* by_upper;
+	range_node_t* nodes;
+	size_t count;
+	size_t num_nodes;
+	size_t root;
+	key_arena_t keys;
+};
+
+typedef struct {
+	size_t lower_offset;
+	size_t upper_offset;
+	size_t lower_length;
+	size_t upper_length;
+} range_offsets_t;
+
+static int compare_endpoints(const endpoint_t* a, const endpoint_t* b) {
+	int res = compare_version_keys(a->key, a->length, b->key, b->length);
+	if (res != 0)
+		return res;
+	return (a->side > b->side) - (a->side < b->side);
+}
+
+static int compare_ids(const range_entry_t* a, const range_entry_t* b) {
+	return a->id < b->id ? -1 : a->id > b->id ? 1 : 0;
+}
+
+static int compare_by_lower(const void* a, const void* b) {
+	const range_entry_t* ea = (const range_entry_t*)a;
+	const range_entry_t* eb = (const range_entry_t*)b;
+	int res = compare_endpoints(&ea->lower, &eb->lower);
+	return res != 0 ? res : compare_ids(ea, eb);
+}
+
+static int compare_by_upper(const void* a, const void* b) {
+	const range_entry_t* ea = (const range_entry_t*)a;
+	const range_entry_t* eb = (const range_entry_t*)b;
+	int res = compare_endpoints(&ea->upper, &eb->upper);
+	return res != 0 ? res : compare_ids(ea, eb);
+}
+
+/* 0 for ranges containing center, -1/1 for ones completely below/above it */
+static int classify_range(const range_entry_t* entry, const endpoint_t* center) {
+	if (compare_endpoints(&entry->upper, center) < 0)
+		return -1;
+	if (compare_endpoints(&entry->lower, center) > 0)
+		return 1;
+	return 0;
+}
+
+/* stable, so sort order is preserved in every part */
+static void partition(range_entry_t* entries, size_t count, const endpoint_t* center, range_entry_t* tmp) {
+	size_t i, pos = 0;
+	int part;
+
+	for (part = -1; part <= 1; part++)
+		for (i = 0; i < count; i++)
+			if (classify_range(&entries[i], center) == part)
+				tmp[pos++] = entries[i];
+
+	memcpy(entries, tmp, count * sizeof(range_entry_t));
+}
+
+/* depth is O(log n) as every child gets at most half of the ranges */
+static size_t build_node(version_range_index_t* index, size_t offset, size_t count, range_entry_t* tmp) {
+	const range_entry_t* by_lower = index->by_lower + offset;
+	const range_entry_t* by_upper = index->by_upper + offset;
+	endpoint_t center;
+	size_t i = 0, j = 0, k, num_left = 0, num_center = 0, x;
+	int part;
+
+	if (count == 0)
+		return NO_NODE;
+
+	/* median of all 2 * count endpoints, by merging sorted ones */
+	center = by_lower[0].lower;
+	for (k = 0; k < count; k++) {
+		if (j == count || (i < count && compare_endpoints(&by_lower[i].lower, &by_upper[j].upper) <= 0))
+			center = by_lower[i++].lower;
+		else
+			center = by_upper[j++].upper;
+	}
+
+	for (k = 0; k < count; k++) {
+		part = classify_range(&by_lower[k], &center);
+		num_left += part < 0;
+		num_center += part == 0;
+	}
+
+	partition(index->by_lower + offset, count, &center, tmp);
+	partition(index->by_upper + offset, count, &center, tmp);
+
+	x = index->num_nodes++;
+	index->nodes[x].center = center;
+	index->nodes[x].offset = offset + num_left;
+	index->nodes[x].count = num_center;
+	index->nodes[x].left = build_node(index, offset, num_left, tmp);
+	index->nodes[x].right = build_node(index, offset + num_left + num_center, count - num_left - num_center, tmp);
+
+	return x;
+}
+
+static int append_endpoint(key_arena_t* keys, const char* v, int flags, int is_upper, size_t* offset, size_t* length) {
+	static const unsigned char infinity = KEY_INFINITY;
+
+	if (v != NULL)
+		return key_arena_append(keys, v, flags, offset, length);
+
+	/* unbounded lower endpoint is an empty key which precedes everything */
+	*length = is_upper ? 1 : 0;
+	return key_arena_append_bytes(keys, &infinity, *length, offset);
+}
+
+version_range_index_t* version_range_index_build(const version_range_t* ranges, size_t count) {
+	version_range_index_t* index;
+	range_offsets_t* offsets = NULL;
+	range_entry_t* tmp = NULL;
+	range_entry_t entry;
+	size_t i;
+
+	if ((index = calloc(1, sizeof(version_range_index_t))) == NULL)
+		return NULL;
+
+	index->root = NO_NODE;
+
+	if (count == 0)
+		return index;
+
+	if ((index->by_lower = malloc(count * sizeof(range_entry_t))) == NULL)
+		goto error;
+	if ((index->by_upper = malloc(count * sizeof(range_entry_t))) == NULL)
+		goto error;
+	if ((index->nodes = malloc(count * sizeof(range_node_t))) == NULL)
+		goto error;
+	if ((offsets = malloc(count * sizeof(range_offsets_t))) == NULL)
+		goto error;
+
+	/* keys are stored by offset while the arena may still be reallocated */
+	for (i = 0; i < count; i++) {
+		if (!append_endpoint(&index->keys, ranges[i].lower, ranges[i].lower_flags, 0, &offsets[i].lower_offset, &offsets[i].lower_length))
+			goto error;
+		if (!append_endpoint(&index->keys, ranges[i].upper, ranges[i].upper_flags, 1, &offsets[i].upper_offset, &offsets[i].upper_length))
+			goto error;
+	}
+
+	for (i = 0; i < count; i++) {
+		entry.lower.key = index->keys.data + offsets[i].lower_offset;
+		entry.lower.length = offsets[i].lower_length;
+		entry.lower.side = (ranges[i].range_flags & VERSIONRANGE_LOWER_EXCLUSIVE) ? 1 : 0;
+		entry.upper.key = index->keys.data + offsets[i].upper_offset;
+		entry.upper.length = offsets[i].upper_length;
+		entry.upper.side = (ranges[i].range_flags & VERSIONRANGE_UPPER_EXCLUSIVE) ? -1 : 0;
+		entry.id = i;
+
+		if (compare_endpoints(&entry.lower, &entry.upper) <= 0)
+			index->by_lower[index->count++] = entry;
+	}
+
+	free(offsets);
+	offsets = NULL;
+
+	memcpy(index->by_upper, index->by_lower, index->count * sizeof(range_entry_t));
+	qsort(index->by_lower, index->count, sizeof(range_entry_t), compare_by_lower);
+	qsort(index->by_upper, index->count, sizeof(range_entry_t), compare_by_upper);
+
+	if ((tmp = malloc(count * sizeof(range_entry_t))) == NULL)
+		goto error;
+
+	index->root = build_node(index, 0, index->count, tmp);
+
+	free(tmp);
+
+	return index;
+
+error:
+	free(offsets);
+	version_range_index_free(index);
+	return NULL;
+}
+
+/* returns nonzero if the query should stop */
+static int report(const range_entry_t* entry, version_range_callback_t callback, void* userdata, size_t* found) {
+	++*found;
+	return callback != NULL && callback(entry->id, userdata);
+}
+
+size_t version_range_index_query(const version_range_index_t* index, const char* v, int flags, version_range_callback_t callback, void* userdata) {
+	const range_node_t* node;
+	endpoint_t point;
+	size_t found = 0, x, i;
+	key_buffer_t key;
+	int res;
+
+	if (index->root == NO_NODE)
+		return 0;
+
+	if (!key_buffer_init(&key, v, flags))
+		return (size_t)-1;
+
+	point.key = key.data;
+	point.length = key.length;
+	point.side = 0;
+
+	for (x = index->root; x != NO_NODE; ) {
+		node = &index->nodes[x];
+		res = compare_endpoints(&point, &node->center);
+
+		if (res < 0) {
+			/* all node ranges end above the version, check where they start */
+			for (i = node->offset; i < node->offset + node->count && compare_endpoints(&index->by_lower[i].lower, &point) <= 0; i++)
+				if (report(&index->by_lower[i], callback, userdata, &found))
+					goto done;
+			x = node->left;
+		} else if (res > 0) {
+			/* all node ranges start below the version, check where they end */
+			for (i = node->offset + node->count; i > node->offset && compare_endpoints(&index->by_upper[i - 1].upper, &point) >= 0; i--)
+				if (report(&index->by_upper[i - 1], callback, userdata, &found))
+					goto done;
+			x = node->right;
+		} else {
+			/* ranges in children are completely below or above the version */
+			for (i = node->offset; i < node->offset + node->count; i++)
+				if (report(&index->by_lower[i], callback, userdata, &found))
+					goto done;
+			break;
+		}
+	}
+
+done:
+	key_buffer_free(&key);
+	return found;
+}
+
+void version_range_index_free(version_range_index_t* index) {
+	if (index == NULL)
+		return;
+
+	key_arena_free(&index->keys);
+	free(index->by_lower);
+	free(index->by_upper);
+	free(index->nodes);
+	free(index);
+}
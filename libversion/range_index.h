@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef LIBVERSION_RANGE_INDEX_H
+#define LIBVERSION_RANGE_INDEX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+
+#include <libversion/export.h>
+
+enum {
+	VERSIONRANGE_LOWER_EXCLUSIVE = 0x1,
+	VERSIONRANGE_UPPER_EXCLUSIVE = 0x2,
+};
+
+typedef struct {
+	const char* lower; /* NULL if unbounded */
+	const char* upper; /* NULL if unbounded */
+	int lower_flags;
+	int upper_flags;
+	int range_flags;
+} version_range_t;
+
+typedef struct version_range_index version_range_index_t;
+
+/* return nonzero to stop the query */
+typedef int (*version_range_callback_t)(size_t range, void* userdata);
+
+extern LIBVERSION_EXPORT version_range_index_t* version_range_index_build(const version_range_t* ranges, size_t count);
+extern LIBVERSION_EXPORT size_t version_range_index_query(const version_range_index_t* index, const char* v, int flags, version_range_callback_t callback, void* userdata);
+extern LIBVERSION_EXPORT void version_range_index_free(version_range_index_t* index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBVERSION_RANGE_INDEX_H */
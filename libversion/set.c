@@ -0,0 +1,327 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#include <libversion/set.h>
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#else
+#include <fcntl.h>
+#include <io.h>
+#include <process.h>
+#include <sys/stat.h>
+#include <windows.h>
+#endif
+
+#include <libversion/private/index_format.h>
+#include <libversion/private/key.h>
+
+typedef struct {
+	uint64_t abbreviated_key;
+	const unsigned char* key;
+	size_t key_length;
+	const char* string;
+} set_entry_t;
+
+struct version_set {
+	set_entry_t* entries;
+	size_t count;
+	int flags;
+	key_arena_t storage;
+};
+
+static int compare_entries(const void* a, const void* b) {
+	const set_entry_t* ea = (const set_entry_t*)a;
+	const set_entry_t* eb = (const set_entry_t*)b;
+	int res;
+
+	/* most pairs are decided without touching the keys */
+	if (ea->abbreviated_key != eb->abbreviated_key)
+		return ea->abbreviated_key < eb->abbreviated_key ? -1 : 1;
+
+	res = compare_version_keys(ea->key, ea->key_length, eb->key, eb->key_length);
+	if (res != 0)
+		return res;
+	return strcmp(ea->string, eb->string);  /* fallback to stringwise comparison for stable ordering */
+}
+
+version_set_t* version_set_build(const char* const* versions, size_t count, int flags) {
+	version_set_t* set;
+	size_t* offsets = NULL;
+	size_t i, string_offset;
+
+	if ((set = calloc(1, sizeof(version_set_t))) == NULL)
+		return NULL;
+
+	set->count = count;
+	set->flags = flags;
+
+	if (count == 0)
+		return set;
+
+	if ((set->entries = malloc(count * sizeof(set_entry_t))) == NULL)
+		goto error;
+	if ((offsets = malloc(count * sizeof(size_t))) == NULL)
+		goto error;
+
+	/* each key is immediately followed by its string */
+	for (i = 0; i < count; i++) {
+		if (!key_arena_append(&set->storage, versions[i], flags, &offsets[i], &set->entries[i].key_length))
+			goto error;
+		if (!key_arena_append_bytes(&set->storage, versions[i], strlen(versions[i]) + 1, &string_offset))
+			goto error;
+	}
+
+	for (i = 0; i < count; i++) {
+		set->entries[i].key = set->storage.data + offsets[i];
+		set->entries[i].string = (const char*)(set->entries[i].key + set->entries[i].key_length);
+		set->entries[i].abbreviated_key = abbreviate_version_key(set->entries[i].key, set->entries[i].key_length);
+	}
+
+	free(offsets);
+
+	qsort(set->entries, count, sizeof(set_entry_t), compare_entries);
+
+	return set;
+
+error:
+	free(offsets);
+	version_set_free(set);
+	return NULL;
+}
+
+#ifndef _WIN32
+static FILE* open_exclusive(const char* path) {
+	int fd;
+	FILE* file;
+
+	if ((fd = open(path, O_WRONLY | O_CREAT | O_EXCL, 0666)) == -1)
+		return NULL;
+	if ((file = fdopen(fd, "wb")) == NULL) {
+		close(fd);
+		remove(path);
+	}
+	return file;
+}
+
+static long process_id(void) {
+	return (long)getpid();
+}
+
+static int sync_file(FILE* file) {
+	return fsync(fileno(file));
+}
+
+static int replace_file(const char* from, const char* to) {
+	return rename(from, to);
+}
+#else
+static FILE* open_exclusive(const char* path) {
+	int fd;
+	FILE* file;
+
+	if ((fd = _open(path, _O_WRONLY | _O_CREAT | _O_EXCL | _O_BINARY, _S_IREAD | _S_IWRITE)) == -1)
+		return NULL;
+	if ((file = _fdopen(fd, "wb")) == NULL) {
+		_close(fd);
+		remove(path);
+	}
+	return file;
+}
+
+static long process_id(void) {
+	return (long)_getpid();
+}
+
+static int sync_file(FILE* file) {
+	return _commit(_fileno(file));
+}
+
+/* rename() does not replace existing files here */
+static int replace_file(const char* from, const char* to) {
+	return MoveFileExA(from, to, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) ? 0 : -1;
+}
+#endif
+
+/* new file in the same directory (so it can be renamed over the target) */
+static FILE* create_temporary(const char* path, char* temporary, size_t size) {
+	FILE* file = NULL;
+	int attempt;
+
+	for (attempt = 0; attempt < 100 && file == NULL; attempt++) {
+		snprintf(temporary, size, "%s.%ld.%d.tmp", path, process_id(), attempt);
+		if ((file = open_exclusive(temporary)) == NULL && errno != EEXIST)
+			return NULL;
+	}
+
+	return file;
+}
+
+static int write_set(const version_set_t* set, FILE* file) {
+	index_header_t header;
+	uint64_t offset = 0;
+	size_t i;
+
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+	header.format = INDEX_FORMAT;
+	header.byte_order = INDEX_BYTE_ORDER;
+	header.flags = (uint32_t)set->flags;
+	header.count = set->count;
+	header.offsets_offset = sizeof(header);
+	header.data_offset = header.offsets_offset + (set->count + 1) * sizeof(uint64_t);
+
+	for (i = 0; i < set->count; i++)
+		header.data_size += set->entries[i].key_length + strlen(set->entries[i].string) + 2;
+
+	if (fwrite(&header, sizeof(header), 1, file) != 1)
+		return 0;
+
+	for (i = 0; i <= set->count; i++) {
+		if (fwrite(&offset, sizeof(offset), 1, file) != 1)
+			return 0;
+		if (i < set->count)
+			offset += set->entries[i].key_length + strlen(set->entries[i].string) + 2;
+	}
+
+	for (i = 0; i < set->count; i++) {
+		if (fwrite(set->entries[i].key, set->entries[i].key_length, 1, file) != 1 || fputc('\0', file) == EOF)
+			return 0;
+		if (fwrite(set->entries[i].string, strlen(set->entries[i].string) + 1, 1, file) != 1)
+			return 0;
+	}
+
+	return fflush(file) == 0 && sync_file(file) == 0;
+}
+
+/* Existing file is replaced atomically, as it may be mapped by readers
+ * which would crash if it was truncated under them */
+int version_set_write(const version_set_t* set, const char* path) {
+	size_t size = strlen(path) + 64;
+	char* temporary;
+	FILE* file;
+	int ok;
+
+	if ((temporary = malloc(size)) == NULL)
+		return 0;
+
+	if ((file = create_temporary(path, temporary, size)) == NULL) {
+		free(temporary);
+		return 0;
+	}
+
+	ok = write_set(set, file);
+	ok = fclose(file) == 0 && ok;
+	ok = ok && replace_file(temporary, path) == 0;
+
+	if (!ok)
+		remove(temporary);
+
+	free(temporary);
+	return ok;
+}
+
+void version_set_free(version_set_t* set) {
+	if (set == NULL)
+		return;
+
+	key_arena_free(&set->storage);
+	free(set->entries);
+	free(set);
+}
+
+size_t version_set_size(const version_set_t* set) {
+	return set->count;
+}
+
+const char* version_set_get(const version_set_t* set, size_t position) {
+	return position < set->count ? set->entries[position].string : NULL;
+}
+
+/* position of the first entry greater than (if strict) or not less than the version */
+static size_t version_set_bound(const version_set_t* set, const char* v, int flags, int strict) {
+	size_t first = 0, count = set->count, step;
+	key_buffer_t key;
+	int res;
+
+	if (!key_buffer_init(&key, v, flags))
+		return VERSIONSET_NONE;
+
+	while (count > 0) {
+		step = count / 2;
+		res = compare_version_keys(set->entries[first + step].key, set->entries[first + step].key_length, key.data, key.length);
+		if (res < 0 || (strict && res == 0)) {
+			first += step + 1;
+			count -= step + 1;
+		} else {
+			count = step;
+		}
+	}
+
+	key_buffer_free(&key);
+	return first;
+}
+
+size_t version_set_lower_bound(const version_set_t* set, const char* v, int flags) {
+	return version_set_bound(set, v, flags, 0);
+}
+
+size_t version_set_upper_bound(const version_set_t* set, const char* v, int flags) {
+	return version_set_bound(set, v, flags, 1);
+}
+
+size_t version_set_predecessor(const version_set_t* set, const char* v, int flags) {
+	size_t position = version_set_bound(set, v, flags, 0);
+	return (position == VERSIONSET_NONE || position == 0) ? VERSIONSET_NONE : position - 1;
+}
+
+size_t version_set_successor(const version_set_t* set, const char* v, int flags) {
+	size_t position = version_set_bound(set, v, flags, 1);
+	return position == set->count ? VERSIONSET_NONE : position;
+}
+
+size_t version_set_rank(const version_set_t* set, const char* v, int flags) {
+	size_t position = version_set_bound(set, v, flags, 1);
+	return position == VERSIONSET_NONE ? VERSIONSET_NONE : set->count - position;
+}
+
+size_t version_set_count_range(const version_set_t* set, const version_range_t* range) {
+	size_t first = 0, last = set->count;
+
+	if (range->lower != NULL)
+		first = version_set_bound(set, range->lower, range->lower_flags, range->range_flags & VERSIONRANGE_LOWER_EXCLUSIVE);
+	if (range->upper != NULL)
+		last = version_set_bound(set, range->upper, range->upper_flags, !(range->range_flags & VERSIONRANGE_UPPER_EXCLUSIVE));
+
+	if (first == VERSIONSET_NONE || last == VERSIONSET_NONE)
+		return VERSIONSET_NONE;
+
+	return last > first ? last - first : 0;
+}
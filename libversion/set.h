@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef LIBVERSION_SET_H
+#define LIBVERSION_SET_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+
+#include <libversion/export.h>
+#include <libversion/range_index.h>
+
+#define VERSIONSET_NONE ((size_t)-1)
+
+typedef struct version_set version_set_t;
+
+extern LIBVERSION_EXPORT version_set_t* version_set_build(const char* const* versions, size_t count, int flags);
+extern LIBVERSION_EXPORT void version_set_free(version_set_t* set);
+
+extern LIBVERSION_EXPORT int version_set_write(const version_set_t* set, const char* path);
+
+extern LIBVERSION_EXPORT size_t version_set_size(const version_set_t* set);
+extern LIBVERSION_EXPORT const char* version_set_get(const version_set_t* set, size_t position);
+
+extern LIBVERSION_EXPORT size_t version_set_lower_bound(const version_set_t* set, const char* v, int flags);
+extern LIBVERSION_EXPORT size_t version_set_upper_bound(const version_set_t* set, const char* v, int flags);
+extern LIBVERSION_EXPORT size_t version_set_predecessor(const version_set_t* set, const char* v, int flags);
+extern LIBVERSION_EXPORT size_t version_set_successor(const version_set_t* set, const char* v, int flags);
+extern LIBVERSION_EXPORT size_t version_set_rank(const version_set_t* set, const char* v, int flags);
+extern LIBVERSION_EXPORT size_t version_set_count_range(const version_set_t* set, const version_range_t* range);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBVERSION_SET_H */
@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <libversion/set_file.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <libversion/private/index_format.h>
+#include <libversion/private/key.h>
+
+/* Reader for files written by version_set_write(). The file is mapped
+ * into memory and queried in place, so opening it takes constant time
+ * regardless of its size. */
+
+struct version_set_file {
+	const unsigned char* base;
+	size_t size;
+	const index_header_t* header;
+	const uint64_t* offsets;
+	const unsigned char* data;
+};
+
+#ifndef _WIN32
+static const unsigned char* load_file(const char* path, size_t* size) {
+	struct stat st;
+	void* base = MAP_FAILED;
+	int fd;
+
+	if ((fd = open(path, O_RDONLY)) == -1)
+		return NULL;
+
+	if (fstat(fd, &st) == 0 && st.st_size > 0 && (uint64_t)st.st_size <= SIZE_MAX) {
+		*size = (size_t)st.st_size;
+		base = mmap(NULL, *size, PROT_READ, MAP_SHARED, fd, 0);
+	}
+
+	close(fd);
+	return base == MAP_FAILED ? NULL : (const unsigned char*)base;
+}
+
+static void unload_file(const unsigned char* base, size_t size) {
+	munmap((void*)base, size);
+}
+#else
+/* no mmap, just read the whole file */
+static const unsigned char* load_file(const char* path, size_t* size) {
+	unsigned char* base = NULL;
+	long length;
+	FILE* file;
+
+	if ((file = fopen(path, "rb")) == NULL)
+		return NULL;
+
+	if (fseek(file, 0, SEEK_END) == 0 && (length = ftell(file)) > 0 && fseek(file, 0, SEEK_SET) == 0) {
+		*size = (size_t)length;
+		if ((base = malloc(*size)) != NULL && fread(base, *size, 1, file) != 1) {
+			free(base);
+			base = NULL;
+		}
+	}
+
+	fclose(file);
+	return base;
+}
+
+static void unload_file(const unsigned char* base, size_t size) {
+	(void)size;
+	free((void*)base);
+}
+#endif
+
+static int check_header(const index_header_t* header, size_t size) {
+	if (size < sizeof(index_header_t))
+		return 0;
+	if (memcmp(header->magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0)
+		return 0;
+	if (header->format != INDEX_FORMAT || header->byte_order != INDEX_BYTE_ORDER)
+		return 0;
+	if (header->offsets_offset % sizeof(uint64_t) != 0 || header->offsets_offset < sizeof(index_header_t) || header->offsets_offset > size)
+		return 0;
+	if (header->count >= (size - header->offsets_offset) / sizeof(uint64_t))
+		return 0;
+	if (header->data_offset < header->offsets_offset + (header->count + 1) * sizeof(uint64_t) || header->data_offset > size)
+		return 0;
+	if (header->data_size != size - header->data_offset)
+		return 0;
+	/* so string functions never run past the end */
+	if (header->data_size > 0 && ((const unsigned char*)header)[size - 1] != '\0')
+		return 0;
+	return 1;
+}
+
+version_set_file_t* version_set_file_open(const char* path) {
+	version_set_file_t* file;
+
+	if ((file = malloc(sizeof(version_set_file_t))) == NULL)
+		return NULL;
+
+	if ((file->base = load_file(path, &file->size)) == NULL) {
+		free(file);
+		return NULL;
+	}
+
+	file->header = (const index_header_t*)file->base;
+
+	if (!check_header(file->header, file->size)) {
+		version_set_file_close(file);
+		return NULL;
+	}
+
+	file->offsets = (const uint64_t*)(file->base + file->header->offsets_offset);
+	file->data = file->base + file->header->data_offset;
+
+	return file;
+}
+
+void version_set_file_close(version_set_file_t* file) {
+	if (file == NULL)
+		return;
+
+	unload_file(file->base, file->size);
+	free(file);
+}
+
+size_t version_set_file_size(const version_set_file_t* file) {
+	return (size_t)file->header->count;
+}
+
+int version_set_file_flags(const version_set_file_t* file) {
+	return (int)file->header->flags;
+}
+
+/* key of the entry, or empty string if the file is corrupt */
+static const char* get_key(const version_set_file_t* file, size_t position) {
+	uint64_t offset = file->offsets[position];
+	return offset < file->header->data_size ? (const char*)file->data + offset : "";
+}
+
+const char* version_set_file_get(const version_set_file_t* file, size_t position) {
+	const char* key;
+	uint64_t offset;
+
+	if (position >= file->header->count)
+		return NULL;
+
+	key = get_key(file, position);
+	offset = (const unsigned char*)key - file->data + strlen(key) + 1;
+
+	return offset < file->header->data_size ? (const char*)file->data + offset : "";
+}
+
+/* position of the first entry greater than (if strict) or not less than the version */
+static size_t version_set_file_bound(const version_set_file_t* file, const char* v, int flags, int strict) {
+	size_t first = 0, count = (size_t)file->header->count, step;
+	const char* entry_key;
+	key_buffer_t key;
+	int res;
+
+	if (!key_buffer_init(&key, v, flags))
+		return VERSIONSET_NONE;
+
+	while (count > 0) {
+		step = count / 2;
+		entry_key = get_key(file, first + step);
+		res = compare_version_keys((const unsigned char*)entry_key, strlen(entry_key), key.data, key.length);
+		if (res < 0 || (strict && res == 0)) {
+			first += step + 1;
+			count -= step + 1;
+		} else {
+			count = step;
+		}
+	}
+
+	key_buffer_free(&key);
+	return first;
+}
+
+size_t version_set_file_lower_bound(const version_set_file_t* file, const char* v, int flags) {
+	return version_set_file_bound(file, v, flags, 0);
+}
+
+size_t version_set_file_upper_bound(const version_set_file_t* file, const char* v, int flags) {
+	return version_set_file_bound(file, v, flags, 1);
+}
+
+size_t version_set_file_count_range(const version_set_file_t* file, const version_range_t* range) {
+	size_t first = 0, last = (size_t)file->header->count;
+
+	if (range->lower != NULL)
+		first = version_set_file_bound(file, range->lower, range->lower_flags, range->range_flags & VERSIONRANGE_LOWER_EXCLUSIVE);
+	if (range->upper != NULL)
+		last = version_set_file_bound(file, range->upper, range->upper_flags, !(range->range_flags & VERSIONRANGE_UPPER_EXCLUSIVE));
+
+	if (first == VERSIONSET_NONE || last == VERSIONSET_NONE)
+		return VERSIONSET_NONE;
+
+	return last > first ? last - first : 0;
+}
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef LIBVERSION_SET_FILE_H
+#define LIBVERSION_SET_FILE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+
+#include <libversion/export.h>
+#include <libversion/range_index.h>
+#include <libversion/set.h>
+
+typedef struct version_set_file version_set_file_t;
+
+extern LIBVERSION_EXPORT version_set_file_t* version_set_file_open(const char* path);
+extern LIBVERSION_EXPORT void version_set_file_close(version_set_file_t* file);
+
+extern LIBVERSION_EXPORT size_t version_set_file_size(const version_set_file_t* file);
+extern LIBVERSION_EXPORT int version_set_file_flags(const version_set_file_t* file);
+extern LIBVERSION_EXPORT const char* version_set_file_get(const version_set_file_t* file, size_t position);
+
+extern LIBVERSION_EXPORT size_t version_set_file_lower_bound(const version_set_file_t* file, const char* v, int flags);
+extern LIBVERSION_EXPORT size_t version_set_file_upper_bound(const version_set_file_t* file, const char* v, int flags);
+extern LIBVERSION_EXPORT size_t version_set_file_count_range(const version_set_file_t* file, const version_range_t* range);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBVERSION_SET_FILE_H */
@@ -0,0 +1,358 @@
+// Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef LIBVERSION_STATIC_VERSION_HPP
+#define LIBVERSION_STATIC_VERSION_HPP
+
+#if __cplusplus < 202002L && (!defined(_MSVC_LANG) || _MSVC_LANG < 202002L)
+#	error libversion/static_version.hpp requires C++20
+#endif
+
+#include <libversion/version.h>
+
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <stdexcept>
+#include <string_view>
+
+// constexpr implementation of version parsing and comparison, same as
+// in libversion/private/parse.c and libversion/private/compare.c, for
+// versions known at compile time
+
+namespace libversion {
+
+namespace detail {
+
+// same as METAORDER_* from libversion/private/component.h
+enum : int {
+	metaorder_lower_bound,
+	metaorder_pre_release,
+	metaorder_zero,
+	metaorder_post_release,
+	metaorder_nonzero,
+	metaorder_letter_suffix,
+	metaorder_upper_bound,
+};
+
+enum : int {
+	keyword_unknown,
+	keyword_pre_release,
+	keyword_post_release,
+};
+
+constexpr bool is_alpha(char c) {
+	return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+constexpr bool is_number(char c) {
+	return c >= '0' && c <= '9';
+}
+
+constexpr char to_lower(char c) {
+	return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+constexpr bool equals_nocase(std::string_view str, std::string_view lowercase) {
+	if (str.size() != lowercase.size())
+		return false;
+	for (std::size_t i = 0; i < str.size(); ++i)
+		if (to_lower(str[i]) != lowercase[i])
+			return false;
+	return true;
+}
+
+constexpr bool starts_with_nocase(std::string_view str, std::string_view lowercase) {
+	return str.size() >= lowercase.size() && equals_nocase(str.substr(0, lowercase.size()), lowercase);
+}
+
+constexpr int classify_keyword(std::string_view str, int flags) {
+	if (equals_nocase(str, "alpha") || equals_nocase(str, "beta") || equals_nocase(str, "rc") || starts_with_nocase(str, "pre"))
+		return keyword_pre_release;
+	else if (starts_with_nocase(str, "post") || starts_with_nocase(str, "patch") || equals_nocase(str, "pl") || equals_nocase(str, "errata"))
+		return keyword_post_release;
+	else if ((flags & VERSIONFLAG_P_IS_PATCH) && equals_nocase(str, "p"))
+		return keyword_post_release;
+	return keyword_unknown;
+}
+
+}
+
+struct version_component {
+	int metaorder = detail::metaorder_zero;
+	std::string_view text;  // empty for zero and padding components
+};
+
+constexpr int compare_components(const version_component& a, const version_component& b) {
+	// metaorder has highest priority
+	if (a.metaorder != b.metaorder)
+		return a.metaorder < b.metaorder ? -1 : 1;
+
+	// empty strings come before everything
+	if (a.text.empty() || b.text.empty())
+		return static_cast<int>(!a.text.empty()) - static_cast<int>(!b.text.empty());
+
+	// alpha come before numbers; only first letter matters
+	const bool a_is_alpha = detail::is_alpha(a.text[0]), b_is_alpha = detail::is_alpha(b.text[0]);
+	if (a_is_alpha && b_is_alpha) {
+		const char ac = detail::to_lower(a.text[0]), bc = detail::to_lower(b.text[0]);
+		return (ac > bc) - (ac < bc);
+	}
+	if (a_is_alpha || b_is_alpha)
+		return a_is_alpha ? -1 : 1;
+
+	// numbers without leading zeroes
+	if (a.text.size() != b.text.size())
+		return a.text.size() < b.text.size() ? -1 : 1;
+	const int res = a.text.compare(b.text);
+	return (res > 0) - (res < 0);
+}
+
+// component which is compared after all components of a version
+constexpr version_component padding_component(int flags) {
+	if (flags & VERSIONFLAG_LOWER_BOUND)
+		return version_component{detail::metaorder_lower_bound, {}};
+	else if (flags & VERSIONFLAG_UPPER_BOUND)
+		return version_component{detail::metaorder_upper_bound, {}};
+	return version_component{detail::metaorder_zero, {}};
+}
+
+// Splits version into components one at a time. Like the C parser,
+// it stops at NUL character as well as at the end of the string.
+class version_tokenizer {
+private:
+	std::string_view str_;
+	std::size_t pos_ = 0;
+	int flags_;
+	version_component pending_;
+	bool has_pending_ = false;
+
+	constexpr bool at_end(std::size_t pos) const {
+		return pos >= str_.size() || str_[pos] == '\0';
+	}
+
+	constexpr char at(std::size_t pos) const {
+		return at_end(pos) ? '\0' : str_[pos];
+	}
+
+	constexpr std::size_t skip_alpha(std::size_t pos) const {
+		while (detail::is_alpha(at(pos)))
+			++pos;
+		return pos;
+	}
+
+public:
+	constexpr version_tokenizer(std::string_view str, int flags) : str_(str), flags_(flags) {
+	}
+
+	constexpr bool next(version_component& component) {
+		if (has_pending_) {
+			component = pending_;
+			has_pending_ = false;
+			return true;
+		}
+
+		while (!at_end(pos_) && !detail::is_alpha(str_[pos_]) && !detail::is_number(str_[pos_]))
+			++pos_;
+
+		if (at_end(pos_))
+			return false;
+
+		if (detail::is_alpha(str_[pos_])) {
+			const std::size_t start = pos_;
+			pos_ = skip_alpha(pos_);
+			component.text = str_.substr(start, pos_ - start);
+			switch (detail::classify_keyword(component.text, flags_)) {
+			case detail::keyword_pre_release:
+				component.metaorder = detail::metaorder_pre_release;
+				break;
+			case detail::keyword_post_release:
+				component.metaorder = detail::metaorder_post_release;
+				break;
+			default:
+				component.metaorder = (flags_ & VERSIONFLAG_ANY_IS_PATCH) ? detail::metaorder_post_release : detail::metaorder_pre_release;
+			}
+		} else {
+			while (at(pos_) == '0')
+				++pos_;
+			const std::size_t start = pos_;
+			while (detail::is_number(at(pos_)))
+				++pos_;
+			component.text = str_.substr(start, pos_ - start);
+			component.metaorder = component.text.empty() ? detail::metaorder_zero : detail::metaorder_nonzero;
+		}
+
+		// letter suffix: alpha not followed by a number, e.g. 1a, 1a.1, but not 1a1
+		if (detail::is_alpha(at(pos_))) {
+			const std::size_t start = pos_, end = skip_alpha(pos_);
+			if (!detail::is_number(at(end))) {
+				pending_.text = str_.substr(start, end - start);
+				switch (detail::classify_keyword(pending_.text, flags_)) {
+				case detail::keyword_pre_release:
+					pending_.metaorder = detail::metaorder_pre_release;
+					break;
+				case detail::keyword_post_release:
+					pending_.metaorder = detail::metaorder_post_release;
+					break;
+				default:
+					pending_.metaorder = detail::metaorder_letter_suffix;
+				}
+				has_pending_ = true;
+				pos_ = end;
+			}
+		}
+
+		return true;
+	}
+};
+
+namespace detail {
+
+// compares two sources of components, each padded after its end
+template<typename Source1, typename Source2>
+constexpr int compare_sources(Source1& a, int a_flags, Source2& b, int b_flags) {
+	version_component ca, cb;
+
+	for (;;) {
+		const bool has_a = a.next(ca), has_b = b.next(cb);
+
+		// paddings are compared once, this matters for bound flags
+		if (!has_a)
+			ca = padding_component(a_flags);
+		if (!has_b)
+			cb = padding_component(b_flags);
+
+		if (const int res = compare_components(ca, cb); res != 0 || (!has_a && !has_b))
+			return res;
+	}
+}
+
+template<typename Iterator>
+class component_range {
+private:
+	Iterator cur_, end_;
+
+public:
+	constexpr component_range(Iterator begin, Iterator end) : cur_(begin), end_(end) {
+	}
+
+	constexpr bool next(version_component& component) {
+		if (cur_ == end_)
+			return false;
+		component = *cur_++;
+		return true;
+	}
+};
+
+}
+
+// Version parsed into components, possibly at compile time. Components
+// refer to the parsed string, so it must outlive the version (which is
+// always the case for string literals).
+template<std::size_t Capacity>
+class static_version {
+private:
+	std::array<version_component, Capacity> components_{};
+	std::size_t size_ = 0;
+	int flags_ = 0;
+
+public:
+	constexpr explicit static_version(std::string_view str, int flags = 0) : flags_(flags) {
+		version_tokenizer tokenizer(str, flags);
+		version_component component;
+		while (tokenizer.next(component)) {
+			if (size_ == Capacity)
+				throw std::length_error("too many version components");
+			components_[size_++] = component;
+		}
+	}
+
+	constexpr std::size_t size() const {
+		return size_;
+	}
+
+	constexpr int flags() const {
+		return flags_;
+	}
+
+	constexpr const version_component* begin() const {
+		return components_.data();
+	}
+
+	constexpr const version_component* end() const {
+		return components_.data() + size_;
+	}
+};
+
+// Parses string literal, with capacity enough for any version of its length
+template<std::size_t N>
+consteval static_version<N> make_static_version(const char (&str)[N], int flags = 0) {
+	return static_version<N>(std::string_view(str, N - 1), flags);
+}
+
+template<std::size_t N1, std::size_t N2>
+constexpr int compare(const static_version<N1>& a, const static_version<N2>& b) {
+	detail::component_range ra(a.begin(), a.end());
+	detail::component_range rb(b.begin(), b.end());
+	return detail::compare_sources(ra, a.flags(), rb, b.flags());
+}
+
+// Compares version string with parsed version; only the string is tokenized
+template<std::size_t N>
+constexpr int compare(std::string_view a, int a_flags, const static_version<N>& b) {
+	version_tokenizer ta(a, a_flags);
+	detail::component_range rb(b.begin(), b.end());
+	return detail::compare_sources(ta, a_flags, rb, b.flags());
+}
+
+template<std::size_t N>
+constexpr int compare(const static_version<N>& a, std::string_view b, int b_flags) {
+	return -compare(b, b_flags, a);
+}
+
+// Compares two version strings, same as version_compare4()
+constexpr int compare(std::string_view a, std::string_view b, int a_flags = 0, int b_flags = 0) {
+	version_tokenizer ta(a, a_flags), tb(b, b_flags);
+	return detail::compare_sources(ta, a_flags, tb, b_flags);
+}
+
+template<std::size_t N1, std::size_t N2>
+constexpr std::strong_ordering operator<=>(const static_version<N1>& a, const static_version<N2>& b) {
+	return compare(a, b) <=> 0;
+}
+
+template<std::size_t N1, std::size_t N2>
+constexpr bool operator==(const static_version<N1>& a, const static_version<N2>& b) {
+	return compare(a, b) == 0;
+}
+
+template<std::size_t N>
+constexpr std::strong_ordering operator<=>(const static_version<N>& a, std::string_view b) {
+	return compare(a, b, 0) <=> 0;
+}
+
+template<std::size_t N>
+constexpr bool operator==(const static_version<N>& a, std::string_view b) {
+	return compare(a, b, 0) == 0;
+}
+
+}
+
+#endif // LIBVERSION_STATIC_VERSION_HPP
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <libversion/stats.h>
+
+#include <libversion/private/stats.h>
+
+#include <string.h>
+
+#ifdef LIBVERSION_STATS
+
+#include <stdlib.h>
+
+#include <libversion/private/mutex.h>
+
+/* blocks of live threads; counters of exited threads are folded into retired */
+static mutex_t registry_mutex = MUTEX_INITIALIZER;
+static stats_block_t* registry = NULL;
+static uint64_t retired[STAT_COUNT];
+
+STATS_THREAD_LOCAL stats_block_t* stats_current_block = NULL;
+
+#ifndef _WIN32
+static pthread_key_t retire_key;
+static pthread_once_t retire_key_once = PTHREAD_ONCE_INIT;
+
+static void retire_block(void* arg) {
+	stats_block_t* block = (stats_block_t*)arg;
+	stats_block_t** cur;
+	size_t i;
+
+	mutex_lock(&registry_mutex);
+	for (i = 0; i < STAT_COUNT; i++)
+		retired[i] += atomic_load_explicit(&block->counters[i], memory_order_relaxed);
+	cur = &registry;
+	while (*cur != block)
+		cur = &(*cur)->next;
+	*cur = block->next;
+	mutex_unlock(&registry_mutex);
+
+	stats_current_block = NULL;
+	free(block);
+}
+
+static void create_retire_key(void) {
+	pthread_key_create(&retire_key, retire_block);
+}
+#endif
+
+stats_block_t* stats_register_block(void) {
+	stats_block_t* block;
+	size_t i;
+
+	if ((block = malloc(sizeof(stats_block_t))) == NULL)
+		return NULL;
+
+	for (i = 0; i < STAT_COUNT; i++)
+		atomic_init(&block->counters[i], 0);
+
+	mutex_lock(&registry_mutex);
+	block->next = registry;
+	registry = block;
+	mutex_unlock(&registry_mutex);
+
+#ifndef _WIN32
+	/* no thread exit hook on windows, so blocks of exited threads stay registered */
+	pthread_once(&retire_key_once, create_retire_key);
+	pthread_setspecific(retire_key, block);
+#endif
+
+	return stats_current_block = block;
+}
+
+int version_stats_snapshot(version_stats_t* stats) {
+	uint64_t totals[STAT_COUNT];
+	const stats_block_t* block;
+	size_t i;
+
+	mutex_lock(&registry_mutex);
+	memcpy(totals, retired, sizeof(totals));
+	for (block = registry; block != NULL; block = block->next)
+		for (i = 0; i < STAT_COUNT; i++)
+			totals[i] += atomic_load_explicit(&block->counters[i], memory_order_relaxed);
+	mutex_unlock(&registry_mutex);
+
+	stats->compare_calls = totals[STAT_COMPARE_CALLS];
+	stats->components_parsed = totals[STAT_COMPONENTS_PARSED];
+	stats->padding_components = totals[STAT_PADDING_COMPONENTS];
+	stats->letter_suffix_lookaheads = totals[STAT_LETTER_SUFFIX_LOOKAHEADS];
+	stats->keywords_unknown = totals[STAT_KEYWORDS_UNKNOWN];
+	stats->keywords_pre_release = totals[STAT_KEYWORDS_PRE_RELEASE];
+	stats->keywords_post_release = totals[STAT_KEYWORDS_POST_RELEASE];
+	stats->keywords_release = totals[STAT_KEYWORDS_RELEASE];
+	stats->equal_results = totals[STAT_EQUAL_RESULTS];
+	for (i = 0; i < VERSION_STATS_DECISION_DEPTH; i++)
+		stats->decided_at[i] = totals[STAT_DECIDED_AT + i];
+	stats->key_calls = totals[STAT_KEY_CALLS];
+	stats->abbreviated_key_calls = totals[STAT_ABBREVIATED_KEY_CALLS];
+	stats->key_compare_calls = totals[STAT_KEY_COMPARE_CALLS];
+
+	return 1;
+}
+
+/* owner threads increment with plain load and store, so this is
+ * only exact when no other thread is counting */
+void version_stats_reset(void) {
+	stats_block_t* block;
+	size_t i;
+
+	mutex_lock(&registry_mutex);
+	memset(retired, 0, sizeof(retired));
+	for (block = registry; block != NULL; block = block->next)
+		for (i = 0; i < STAT_COUNT; i++)
+			atomic_store_explicit(&block->counters[i], 0, memory_order_relaxed);
+	mutex_unlock(&registry_mutex);
+}
+
+#else
+
+int version_stats_snapshot(version_stats_t* stats) {
+	memset(stats, 0, sizeof(version_stats_t));
+	return 0;
+}
+
+void version_stats_reset(void) {
+}
+
+#endif
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef LIBVERSION_STATS_H
+#define LIBVERSION_STATS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#include <libversion/export.h>
+
+#define VERSION_STATS_DECISION_DEPTH 16
+
+typedef struct {
+	uint64_t compare_calls;
+	uint64_t components_parsed;
+	uint64_t padding_components;
+	uint64_t letter_suffix_lookaheads;
+	uint64_t keywords_unknown;
+	uint64_t keywords_pre_release;
+	uint64_t keywords_post_release;
+	uint64_t keywords_release;
+	uint64_t equal_results;
+	uint64_t decided_at[VERSION_STATS_DECISION_DEPTH]; /* last one also counts deeper decisions */
+	/* sort key paths, which don't go through version_compare4 */
+	uint64_t key_calls;
+	uint64_t abbreviated_key_calls;
+	uint64_t key_compare_calls;
+} version_stats_t;
+
+extern LIBVERSION_EXPORT int version_stats_snapshot(version_stats_t* stats);
+extern LIBVERSION_EXPORT void version_stats_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBVERSION_STATS_H */
@@ -0,0 +1,462 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#include <libversion/trie.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <libversion/private/key.h>
+#include <libversion/version.h>
+
+/* Trie over comparable keys, where each component code (with digits
+ * for numbers) is split into chunks of up to 4 bytes. Nodes are stored
+ * in preorder, so children of a node follow it and subtree sizes are
+ * enough to navigate. Keys of all versions ending at a node only
+ * differ by a terminating byte, so instead of a child it's marked with
+ * a flag; in version order it goes before children with greater codes.
+ * Numbers of versions in subtrees allow to translate key bounds into
+ * version ranks and back. */
+
+#define MY_MIN(a, b) ((a) < (b) ? (a) : (b))
+
+#define TERMINAL_FLAG ((uint32_t)1 << 31)
+
+enum {
+	CHUNK_SIZE = 4,
+};
+
+typedef struct {
+	uint32_t size; /* nodes in the subtree, with TERMINAL_FLAG if a version ends here */
+	uint32_t count; /* versions in the subtree */
+	unsigned char chunk[CHUNK_SIZE]; /* zero padded */
+} trie_node_t;
+
+struct version_trie {
+	trie_node_t* nodes;
+	size_t num_nodes;
+	size_t* values;
+	size_t count;
+	int flags;
+};
+
+typedef struct {
+	const unsigned char* key;
+	size_t length;
+	size_t id;
+} trie_entry_t;
+
+static size_t node_size(const trie_node_t* node) {
+	return node->size & ~TERMINAL_FLAG;
+}
+
+static int node_is_terminal(const trie_node_t* node) {
+	return (node->size & TERMINAL_FLAG) != 0;
+}
+
+static size_t chunk_length(const trie_node_t* node) {
+	size_t len = 0;
+	while (len < CHUNK_SIZE && node->chunk[len] != 0)
+		len++;
+	return len;
+}
+
+static size_t next_chunk_length(const unsigned char* key, size_t pos, size_t* token_end) {
+	if (pos == *token_end)
+		*token_end = pos + get_key_token_length(key + pos);
+	return MY_MIN(CHUNK_SIZE, *token_end - pos);
+}
+
+static int compare_entries(const void* a, const void* b) {
+	const trie_entry_t* ea = (const trie_entry_t*)a;
+	const trie_entry_t* eb = (const trie_entry_t*)b;
+	int res = compare_version_keys(ea->key, ea->length, eb->key, eb->length);
+	if (res != 0)
+		return res;
+	return ea->id < eb->id ? -1 : ea->id > eb->id ? 1 : 0;
+}
+
+static int append_node(version_trie_t* trie, size_t* capacity, const unsigned char* chunk, size_t len) {
+	trie_node_t* nodes;
+
+	if (trie->num_nodes == *capacity) {
+		if (*capacity >= TERMINAL_FLAG / 2)
+			return 0;
+		if ((nodes = realloc(trie->nodes, *capacity * 2 * sizeof(trie_node_t))) == NULL)
+			return 0;
+		trie->nodes = nodes;
+		*capacity *= 2;
+	}
+
+	memset(&trie->nodes[trie->num_nodes], 0, sizeof(trie_node_t));
+	if (len > 0)
+		memcpy(trie->nodes[trie->num_nodes].chunk, chunk, len);
+	trie->num_nodes++;
+	return 1;
+}
+
+static void close_node(version_trie_t* trie, const size_t* path, size_t depth) {
+	trie_node_t* node = &trie->nodes[path[depth]];
+
+	node->size |= trie->num_nodes - path[depth];
+	if (depth > 0)
+		trie->nodes[path[depth - 1]].count += node->count;
+}
+
+/* entries are sorted and unique; path holds indexes of nodes along the previous key */
+static int build_nodes(version_trie_t* trie, const trie_entry_t* entries, size_t count) {
+	size_t capacity = 64, path_capacity = 64, depth = 0, i, pos, len, token_end, path_length, matched;
+	size_t* path;
+	size_t* new_path;
+
+	if ((trie->nodes = malloc(capacity * sizeof(trie_node_t))) == NULL)
+		return 0;
+	if ((path = malloc(path_capacity * sizeof(size_t))) == NULL)
+		return 0;
+
+	append_node(trie, &capacity, NULL, 0);
+	path[0] = 0;
+
+	for (i = 0; i < count; i++) {
+		/* the terminating byte is not stored */
+		path_length = entries[i].length - 1;
+
+		/* skip chunks shared with the previous key */
+		for (pos = 0, token_end = 0, matched = 0; pos < path_length; pos += len, matched++) {
+			len = next_chunk_length(entries[i].key, pos, &token_end);
+			if (matched == depth)
+				break;
+			if (chunk_length(&trie->nodes[path[matched + 1]]) != len || memcmp(trie->nodes[path[matched + 1]].chunk, entries[i].key + pos, len) != 0)
+				break;
+		}
+
+		for (; depth > matched; depth--)
+			close_node(trie, path, depth);
+
+		for (; pos < path_length; pos += len) {
+			len = next_chunk_length(entries[i].key, pos, &token_end);
+
+			if (depth + 1 == path_capacity) {
+				if ((new_path = realloc(path, path_capacity * 2 * sizeof(size_t))) == NULL)
+					goto error;
+				path = new_path;
+				path_capacity *= 2;
+			}
+
+			path[++depth] = trie->num_nodes;
+			if (!append_node(trie, &capacity, entries[i].key + pos, len))
+				goto error;
+		}
+
+		trie->nodes[path[depth]].size |= TERMINAL_FLAG;
+		trie->nodes[path[depth]].count++;
+	}
+
+	for (; depth > 0; depth--)
+		close_node(trie, path, depth);
+	close_node(trie, path, 0);
+
+	free(path);
+	return 1;
+
+error:
+	free(path);
+	return 0;
+}
+
+version_trie_t* version_trie_build(const char* const* versions, const size_t* values, size_t count, int flags) {
+	version_trie_t* trie;
+	trie_entry_t* entries = NULL;
+	key_arena_t keys = { NULL, 0, 0 };
+	size_t i, unique;
+
+	if ((trie = calloc(1, sizeof(version_trie_t))) == NULL)
+		return NULL;
+
+	/* stored versions are always exact */
+	trie->flags = flags & ~(VERSIONFLAG_LOWER_BOUND | VERSIONFLAG_UPPER_BOUND);
+
+	if ((entries = malloc((count ? count : 1) * sizeof(trie_entry_t))) == NULL)
+		goto error;
+
+	/* key offsets are kept in ids while the arena may still be reallocated */
+	for (i = 0; i < count; i++)
+		if (!key_arena_append(&keys, versions[i], trie->flags, &entries[i].id, &entries[i].length))
+			goto error;
+
+	for (i = 0; i < count; i++) {
+		entries[i].key = keys.data + entries[i].id;
+		entries[i].id = i;
+	}
+
+	qsort(entries, count, sizeof(trie_entry_t), compare_entries);
+
+	/* versions which compare equal are merged, first one wins */
+	for (i = 0, unique = 0; i < count; i++)
+		if (unique == 0 || compare_version_keys(entries[unique - 1].key, entries[unique - 1].length, entries[i].key, entries[i].length) != 0)
+			entries[unique++] = entries[i];
+
+	trie->count = unique;
+
+	if (values != NULL) {
+		if ((trie->values = malloc((unique ? unique : 1) * sizeof(size_t))) == NULL)
+			goto error;
+		for (i = 0; i < unique; i++)
+			trie->values[i] = values[entries[i].id];
+	}
+
+	if (!build_nodes(trie, entries, unique))
+		goto error;
+
+	free(entries);
+	key_arena_free(&keys);
+	return trie;
+
+error:
+	free(entries);
+	key_arena_free(&keys);
+	version_trie_free(trie);
+	return NULL;
+}
+
+void version_trie_free(version_trie_t* trie) {
+	if (trie == NULL)
+		return;
+
+	free(trie->nodes);
+	free(trie->values);
+	free(trie);
+}
+
+size_t version_trie_size(const version_trie_t* trie) {
+	return trie->count;
+}
+
+size_t version_trie_memory_usage(const version_trie_t* trie) {
+	return sizeof(version_trie_t) + trie->num_nodes * sizeof(trie_node_t) + (trie->values ? trie->count * sizeof(size_t) : 0);
+}
+
+/* number of versions less than (or, if inclusive, not greater than) the key */
+static size_t trie_rank(const version_trie_t* trie, const unsigned char* key, size_t key_len, int inclusive) {
+	size_t rank = 0, pos = 0, node = 0, child, end, len;
+	int terminal_pending, res;
+
+	for (;;) {
+		terminal_pending = node_is_terminal(&trie->nodes[node]);
+		end = node + node_size(&trie->nodes[node]);
+
+		for (child = node + 1; ; child += node_size(&trie->nodes[child])) {
+			if (terminal_pending && (child == end || trie->nodes[child].chunk[0] > KEY_END)) {
+				terminal_pending = 0;
+				if (key[pos] == KEY_END)
+					return rank + (inclusive ? 1 : 0);
+				if (key[pos] < KEY_END)
+					return rank;
+				rank++;
+			}
+
+			if (child == end)
+				return rank;
+
+			len = chunk_length(&trie->nodes[child]);
+			res = memcmp(trie->nodes[child].chunk, key + pos, MY_MIN(len, key_len - pos));
+			if (res > 0)
+				return rank;
+			if (res == 0)
+				break;
+			rank += trie->nodes[child].count;
+		}
+
+		node = child;
+		pos += len;
+	}
+}
+
+typedef struct {
+	size_t node;
+	size_t next_child;
+	size_t rank;
+	size_t prefix_length;
+	int terminal_done;
+} trie_frame_t;
+
+typedef struct {
+	trie_frame_t* frames;
+	size_t depth;
+	size_t frames_capacity;
+	unsigned char* prefix;
+	size_t prefix_capacity;
+	char* version;
+	size_t version_capacity;
+} trie_walk_t;
+
+static int grow(void** data, size_t* capacity, size_t needed, size_t item_size) {
+	size_t new_capacity = *capacity ? *capacity : 64;
+	void* new_data;
+
+	if (needed <= *capacity)
+		return 1;
+
+	while (new_capacity < needed)
+		new_capacity *= 2;
+
+	if ((new_data = realloc(*data, new_capacity * item_size)) == NULL)
+		return 0;
+
+	*data = new_data;
+	*capacity = new_capacity;
+	return 1;
+}
+
+static int push_frame(trie_walk_t* walk, const version_trie_t* trie, size_t node, size_t rank, size_t prefix_length) {
+	trie_frame_t* frame;
+
+	if (!grow((void**)&walk->frames, &walk->frames_capacity, walk->depth + 1, sizeof(trie_frame_t)))
+		return 0;
+
+	frame = &walk->frames[walk->depth++];
+	frame->node = node;
+	frame->next_child = node_size(&trie->nodes[node]) > 1 ? node + 1 : (size_t)-1;
+	frame->rank = rank;
+	frame->prefix_length = prefix_length;
+	frame->terminal_done = 0;
+	return 1;
+}
+
+/* calls back for versions with ranks in [first, last) in order */
+static size_t trie_walk(const version_trie_t* trie, size_t first, size_t last, version_trie_callback_t callback, void* userdata) {
+	trie_walk_t walk;
+	trie_frame_t* frame;
+	size_t reported = 0, child, len, version_len;
+
+	if (first >= last)
+		return 0;
+
+	memset(&walk, 0, sizeof(walk));
+
+	if (!push_frame(&walk, trie, 0, 0, 0))
+		goto error;
+
+	while (walk.depth > 0) {
+		frame = &walk.frames[walk.depth - 1];
+		child = frame->next_child;
+
+		if (frame->rank >= last)
+			break;
+
+		if (!frame->terminal_done && node_is_terminal(&trie->nodes[frame->node]) && (child == (size_t)-1 || trie->nodes[child].chunk[0] > KEY_END)) {
+			frame->terminal_done = 1;
+			if (frame->rank++ < first)
+				continue;
+
+			version_len = make_version_from_key(walk.prefix, frame->prefix_length, walk.version, walk.version_capacity);
+			if (version_len >= walk.version_capacity) {
+				if (!grow((void**)&walk.version, &walk.version_capacity, version_len + 1, 1))
+					goto error;
+				make_version_from_key(walk.prefix, frame->prefix_length, walk.version, walk.version_capacity);
+			}
+
+			reported++;
+			if (callback != NULL && callback(walk.version, trie->values ? trie->values[frame->rank - 1] : frame->rank - 1, userdata))
+				break;
+			continue;
+		}
+
+		if (child == (size_t)-1) {
+			walk.depth--;
+			continue;
+		}
+
+		frame->next_child = child + node_size(&trie->nodes[child]);
+		if (frame->next_child == frame->node + node_size(&trie->nodes[frame->node]))
+			frame->next_child = (size_t)-1;
+
+		if (frame->rank + trie->nodes[child].count <= first) {
+			/* skip subtree entirely before the requested range */
+			frame->rank += trie->nodes[child].count;
+			continue;
+		}
+
+		len = chunk_length(&trie->nodes[child]);
+		if (!grow((void**)&walk.prefix, &walk.prefix_capacity, frame->prefix_length + len, 1))
+			goto error;
+		memcpy(walk.prefix + frame->prefix_length, trie->nodes[child].chunk, len);
+
+		frame->rank += trie->nodes[child].count;
+		if (!push_frame(&walk, trie, child, frame->rank - trie->nodes[child].count, frame->prefix_length + len))
+			goto error;
+	}
+
+	free(walk.frames);
+	free(walk.prefix);
+	free(walk.version);
+	return reported;
+
+error:
+	free(walk.frames);
+	free(walk.prefix);
+	free(walk.version);
+	return (size_t)-1;
+}
+
+/* ranks of versions which belong to the release */
+static int release_ranks(const version_trie_t* trie, const char* release, size_t* first, size_t* last) {
+	key_buffer_t key;
+
+	if (release == NULL) {
+		*first = 0;
+		*last = trie->count;
+		return 1;
+	}
+
+	if (!key_buffer_init(&key, release, trie->flags | VERSIONFLAG_LOWER_BOUND))
+		return 0;
+	*first = trie_rank(trie, key.data, key.length, 0);
+	key_buffer_free(&key);
+
+	if (!key_buffer_init(&key, release, trie->flags | VERSIONFLAG_UPPER_BOUND))
+		return 0;
+	*last = trie_rank(trie, key.data, key.length, 1);
+	key_buffer_free(&key);
+
+	return 1;
+}
+
+size_t version_trie_foreach(const version_trie_t* trie, const char* release, version_trie_callback_t callback, void* userdata) {
+	size_t first, last;
+
+	if (!release_ranks(trie, release, &first, &last))
+		return (size_t)-1;
+
+	return trie_walk(trie, first, last, callback, userdata);
+}
+
+size_t version_trie_newest(const version_trie_t* trie, const char* release, version_trie_callback_t callback, void* userdata) {
+	size_t first, last;
+
+	if (!release_ranks(trie, release, &first, &last))
+		return (size_t)-1;
+
+	return last > first ? trie_walk(trie, last - 1, last, callback, userdata) : 0;
+}
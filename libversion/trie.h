@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef LIBVERSION_TRIE_H
+#define LIBVERSION_TRIE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+
+#include <libversion/export.h>
+
+typedef struct version_trie version_trie_t;
+
+/* return nonzero to stop the iteration */
+typedef int (*version_trie_callback_t)(const char* version, size_t value, void* userdata);
+
+extern LIBVERSION_EXPORT version_trie_t* version_trie_build(const char* const* versions, const size_t* values, size_t count, int flags);
+extern LIBVERSION_EXPORT void version_trie_free(version_trie_t* trie);
+
+extern LIBVERSION_EXPORT size_t version_trie_size(const version_trie_t* trie);
+extern LIBVERSION_EXPORT size_t version_trie_memory_usage(const version_trie_t* trie);
+
+extern LIBVERSION_EXPORT size_t version_trie_foreach(const version_trie_t* trie, const char* release, version_trie_callback_t callback, void* userdata);
+extern LIBVERSION_EXPORT size_t version_trie_newest(const version_trie_t* trie, const char* release, version_trie_callback_t callback, void* userdata);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBVERSION_TRIE_H */
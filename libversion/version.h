@@ -27,6 +27,9 @@
 extern "C" {
 #endif
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include <libversion/config.h>
 #include <libversion/export.h>
 
@@ -47,6 +50,27 @@ enum {
 extern LIBVERSION_EXPORT int version_compare2(const char* v1, const char* v2);
 extern LIBVERSION_EXPORT int version_compare4(const char* v1, const char* v2, int v1_flags, int v2_flags);
 
+extern LIBVERSION_EXPORT size_t version_sort_key(const char* v, int flags, unsigned char* buf, size_t size);
+extern LIBVERSION_EXPORT uint64_t version_abbreviated_key(const char* v, int flags);
+extern LIBVERSION_EXPORT uint64_t version_abbreviate_sort_key(const unsigned char* key, size_t length);
+
+/* kinds of components found in a version */
+enum {
+	VERSIONCLASS_PRE_RELEASE = 0x1,
+	VERSIONCLASS_ZERO = 0x2,
+	VERSIONCLASS_POST_RELEASE = 0x4,
+	VERSIONCLASS_NONZERO = 0x8,
+	VERSIONCLASS_LETTER_SUFFIX = 0x10,
+	VERSIONCLASS_UNKNOWN_KEYWORD = 0x20,  /* alphabetic component which is not a known keyword */
+};
+
+typedef struct {
+	int classes;        /* VERSIONCLASS_* bitmask */
+	size_t components;
+} version_class_t;
+
+extern LIBVERSION_EXPORT void version_classify(const char* v, int flags, version_class_t* result);
+
 #ifdef __cplusplus
 }
 #endif
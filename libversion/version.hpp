@@ -0,0 +1,232 @@
+// Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef LIBVERSION_VERSION_HPP
+#define LIBVERSION_VERSION_HPP
+
+#if __cplusplus < 202002L && (!defined(_MSVC_LANG) || _MSVC_LANG < 202002L)
+#	error libversion/version.hpp requires C++20
+#endif
+
+#include <libversion/version.h>
+#include <libversion/version_inline.h>
+
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace libversion {
+
+namespace flags {
+
+inline constexpr int p_is_patch = VERSIONFLAG_P_IS_PATCH;
+inline constexpr int any_is_patch = VERSIONFLAG_ANY_IS_PATCH;
+inline constexpr int lower_bound = VERSIONFLAG_LOWER_BOUND;
+inline constexpr int upper_bound = VERSIONFLAG_UPPER_BOUND;
+
+}
+
+namespace detail {
+
+inline constexpr int all_flags = flags::p_is_patch | flags::any_is_patch | flags::lower_bound | flags::upper_bound;
+
+// enough for most real world versions and their keys, longer ones go to the heap
+inline constexpr std::size_t inline_size = 128;
+
+// calls func with NUL terminated copy of a string view, which is placed on stack
+template<typename Func>
+decltype(auto) with_c_str(std::string_view str, Func&& func) {
+	if (str.size() < inline_size) {
+		std::array<char, inline_size> buffer;
+		std::memcpy(buffer.data(), str.data(), str.size());
+		buffer[str.size()] = '\0';
+		return std::forward<Func>(func)(buffer.data());
+	}
+
+	const std::string copy(str);
+	return std::forward<Func>(func)(copy.c_str());
+}
+
+// calls func with sort key (as std::string_view) of a version, which is placed on stack
+template<typename Func>
+decltype(auto) with_key(const char* version, int flags, Func&& func) {
+	std::array<unsigned char, inline_size * 2> buffer;
+	std::size_t length = version_sort_key(version, flags, buffer.data(), buffer.size());
+
+	if (length <= buffer.size())
+		return std::forward<Func>(func)(std::string_view(reinterpret_cast<const char*>(buffer.data()), length));
+
+	std::string key(length, '\0');
+	version_sort_key(version, flags, reinterpret_cast<unsigned char*>(key.data()), length);
+	return std::forward<Func>(func)(std::string_view(key));
+}
+
+inline std::string make_key(const char* version, int flags) {
+	return with_key(version, flags, [](std::string_view key) { return std::string(key); });
+}
+
+inline std::strong_ordering to_ordering(int res) noexcept {
+	return res < 0 ? std::strong_ordering::less : res > 0 ? std::strong_ordering::greater : std::strong_ordering::equal;
+}
+
+}
+
+// Non-owning version, which only refers to a string. Comparisons parse
+// the string each time, but do not allocate memory (unless the string
+// is unusually long). Comparisons of two views use inline implementation
+// (libversion/version_inline.h), so Flags are constants there and their
+// checks are folded at compile time.
+template<int Flags = 0>
+class basic_version_view {
+	static_assert((Flags & ~detail::all_flags) == 0, "unknown version flags");
+
+private:
+	std::string_view string_;
+
+public:
+	static constexpr int version_flags = Flags;
+
+	constexpr basic_version_view() noexcept = default;
+
+	constexpr explicit basic_version_view(std::string_view string) noexcept : string_(string) {
+	}
+
+	constexpr std::string_view str() const noexcept {
+		return string_;
+	}
+
+	// sort key, see version_sort_key()
+	std::string key() const {
+		return detail::with_c_str(string_, [](const char* v) { return detail::make_key(v, Flags); });
+	}
+};
+
+// Owning version, which is parsed once on construction: it keeps
+// memcmp-comparable sort key along with the string, so comparisons
+// and hashing do not need to parse it again. Keys are built by the
+// library, which gets Flags as a plain runtime argument.
+template<int Flags = 0>
+class basic_version {
+	static_assert((Flags & ~detail::all_flags) == 0, "unknown version flags");
+
+private:
+	std::string string_;
+	std::string key_;
+
+public:
+	static constexpr int version_flags = Flags;
+
+	basic_version() : key_(detail::make_key("", Flags)) {
+	}
+
+	explicit basic_version(std::string string) : string_(std::move(string)), key_(detail::make_key(string_.c_str(), Flags)) {
+	}
+
+	explicit basic_version(std::string_view string) : basic_version(std::string(string)) {
+	}
+
+	explicit basic_version(const char* string) : basic_version(std::string(string)) {
+	}
+
+	explicit basic_version(basic_version_view<Flags> view) : basic_version(std::string(view.str())) {
+	}
+
+	const std::string& str() const noexcept {
+		return string_;
+	}
+
+	// sort key, see version_sort_key()
+	std::string_view key() const noexcept {
+		return key_;
+	}
+
+	basic_version_view<Flags> view() const noexcept {
+		return basic_version_view<Flags>(string_);
+	}
+};
+
+// Note that equal versions are not necessarily equal strings, e.g. 1.0 == 1.0.0
+
+template<int Flags1, int Flags2>
+std::strong_ordering operator<=>(const basic_version<Flags1>& a, const basic_version<Flags2>& b) noexcept {
+	return a.key() <=> b.key();
+}
+
+template<int Flags1, int Flags2>
+bool operator==(const basic_version<Flags1>& a, const basic_version<Flags2>& b) noexcept {
+	return a.key() == b.key();
+}
+
+template<int Flags1, int Flags2>
+std::strong_ordering operator<=>(basic_version_view<Flags1> a, basic_version_view<Flags2> b) {
+	return detail::with_c_str(a.str(), [b](const char* v1) {
+		return detail::with_c_str(b.str(), [v1](const char* v2) {
+			return detail::to_ordering(version_compare4_inline(v1, v2, Flags1, Flags2));
+		});
+	});
+}
+
+template<int Flags1, int Flags2>
+bool operator==(basic_version_view<Flags1> a, basic_version_view<Flags2> b) {
+	return (a <=> b) == 0;
+}
+
+template<int Flags1, int Flags2>
+std::strong_ordering operator<=>(const basic_version<Flags1>& a, basic_version_view<Flags2> b) {
+	return detail::with_c_str(b.str(), [&a](const char* v2) {
+		return detail::with_key(v2, Flags2, [&a](std::string_view key) { return a.key() <=> key; });
+	});
+}
+
+template<int Flags1, int Flags2>
+bool operator==(const basic_version<Flags1>& a, basic_version_view<Flags2> b) {
+	return (a <=> b) == 0;
+}
+
+using version = basic_version<>;
+using version_view = basic_version_view<>;
+
+}
+
+// Hashes of equal versions and views are equal, regardless of flags
+// and string representation.
+
+template<int Flags>
+struct std::hash<libversion::basic_version<Flags>> {
+	std::size_t operator()(const libversion::basic_version<Flags>& v) const noexcept {
+		return std::hash<std::string_view>()(v.key());
+	}
+};
+
+template<int Flags>
+struct std::hash<libversion::basic_version_view<Flags>> {
+	std::size_t operator()(libversion::basic_version_view<Flags> v) const {
+		return libversion::detail::with_c_str(v.str(), [](const char* str) {
+			return libversion::detail::with_key(str, Flags, [](std::string_view key) { return std::hash<std::string_view>()(key); });
+		});
+	}
+};
+
+#endif // LIBVERSION_VERSION_HPP
@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#define LIBVERSION_NO_DEPRECATED /* disable deprecated APIs */
+
+#include <sqlite3ext.h>
+SQLITE_EXTENSION_INIT1
+
+#include <libversion/version.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef SQLITE_INNOCUOUS
+#	define FUNCTION_FLAGS (SQLITE_UTF8 | SQLITE_DETERMINISTIC | SQLITE_INNOCUOUS)
+#else
+#	define FUNCTION_FLAGS (SQLITE_UTF8 | SQLITE_DETERMINISTIC)
+#endif
+
+/* enough for any sane version; longer ones go to the heap */
+#define STACK_VERSION_SIZE 256
+#define STACK_KEY_SIZE 256
+
+/* Collation callbacks get text which is not necessarily NUL terminated,
+ * while the parser needs terminated strings, so it's copied into
+ * a stack buffer (heap one is only used for unusually long versions) */
+typedef struct {
+	char* data;
+	char inline_data[STACK_VERSION_SIZE];
+} version_buffer_t;
+
+static const char* version_buffer_init(version_buffer_t* buffer, const void* data, int length) {
+	size_t size = (size_t)length;
+
+	buffer->data = buffer->inline_data;
+	if (size >= sizeof(buffer->inline_data) && (buffer->data = malloc(size + 1)) == NULL)
+		return NULL;
+
+	if (size > 0)
+		memcpy(buffer->data, data, size);
+	buffer->data[size] = '\0';
+	return buffer->data;
+}
+
+static void version_buffer_free(version_buffer_t* buffer) {
+	if (buffer->data != buffer->inline_data)
+		free(buffer->data);
+}
+
+static int version_collation(void* arg, int length1, const void* data1, int length2, const void* data2) {
+	version_buffer_t buffer1, buffer2;
+	const char *v1, *v2;
+	int res = 0;
+
+	(void)arg;
+
+	v1 = version_buffer_init(&buffer1, data1, length1);
+	v2 = version_buffer_init(&buffer2, data2, length2);
+
+	/* collation cannot fail, so out of memory falls back to bytewise order */
+	if (v1 != NULL && v2 != NULL) {
+		res = version_compare4(v1, v2, 0, 0);
+	} else {
+		if (length1 > 0 && length2 > 0)
+			res = memcmp(data1, data2, (size_t)(length1 < length2 ? length1 : length2));
+		if (res == 0)
+			res = (length1 > length2) - (length1 < length2);
+	}
+
+	if (v1 != NULL)
+		version_buffer_free(&buffer1);
+	if (v2 != NULL)
+		version_buffer_free(&buffer2);
+
+	return res;
+}
+
+static int get_flags(sqlite3_context* context, int argc, sqlite3_value** argv, int index, int* flags) {
+	*flags = 0;
+	if (index >= argc || sqlite3_value_type(argv[index]) == SQLITE_NULL)
+		return 1;
+
+	if (sqlite3_value_type(argv[index]) != SQLITE_INTEGER) {
+		sqlite3_result_error(context, "version flags must be an integer", -1);
+		return 0;
+	}
+
+	*flags = sqlite3_value_int(argv[index]);
+	return 1;
+}
+
+/* version_compare(v1, v2 [, v1_flags, v2_flags]) */
+static void version_compare_function(sqlite3_context* context, int argc, sqlite3_value** argv) {
+	const char *v1, *v2;
+	int flags1, flags2;
+
+	if (!get_flags(context, argc, argv, 2, &flags1) || !get_flags(context, argc, argv, 3, &flags2))
+		return;
+
+	if (sqlite3_value_type(argv[0]) == SQLITE_NULL || sqlite3_value_type(argv[1]) == SQLITE_NULL)
+		return;
+
+	if ((v1 = (const char*)sqlite3_value_text(argv[0])) == NULL || (v2 = (const char*)sqlite3_value_text(argv[1])) == NULL) {
+		sqlite3_result_error_nomem(context);
+		return;
+	}
+
+	sqlite3_result_int(context, version_compare4(v1, v2, flags1, flags2));
+}
+
+/* version_key(v [, flags]) */
+static void version_key_function(sqlite3_context* context, int argc, sqlite3_value** argv) {
+	unsigned char inline_key[STACK_KEY_SIZE];
+	unsigned char* key = inline_key;
+	const char* v;
+	size_t length;
+	int flags;
+
+	if (!get_flags(context, argc, argv, 1, &flags))
+		return;
+
+	if (sqlite3_value_type(argv[0]) == SQLITE_NULL)
+		return;
+
+	if ((v = (const char*)sqlite3_value_text(argv[0])) == NULL) {
+		sqlite3_result_error_nomem(context);
+		return;
+	}
+
+	length = version_sort_key(v, flags, inline_key, sizeof(inline_key));
+	if (length > sizeof(inline_key)) {
+		if ((key = sqlite3_malloc64(length)) == NULL) {
+			sqlite3_result_error_nomem(context);
+			return;
+		}
+		version_sort_key(v, flags, key, length);
+		sqlite3_result_blob64(context, key, length, sqlite3_free);
+	} else {
+		sqlite3_result_blob64(context, key, length, SQLITE_TRANSIENT);
+	}
+}
+
+/* version_max(v [, flags]) and version_min(v [, flags]) aggregates */
+typedef struct {
+	char* best;
+	int flags;
+} aggregate_state_t;
+
+static void version_aggregate_step(sqlite3_context* context, int argc, sqlite3_value** argv) {
+	int direction = *(int*)sqlite3_user_data(context);
+	aggregate_state_t* state;
+	const char* v;
+	char* copy;
+	int flags, length;
+
+	if (!get_flags(context, argc, argv, 1, &flags))
+		return;
+
+	if (sqlite3_value_type(argv[0]) == SQLITE_NULL)
+		return;
+
+	if ((state = sqlite3_aggregate_context(context, sizeof(aggregate_state_t))) == NULL || (v = (const char*)sqlite3_value_text(argv[0])) == NULL) {
+		sqlite3_result_error_nomem(context);
+		return;
+	}
+
+	/* first of equal versions wins */
+	if (state->best != NULL && version_compare4(v, state->best, flags, state->flags) * direction <= 0)
+		return;
+
+	length = sqlite3_value_bytes(argv[0]);
+	if ((copy = sqlite3_malloc(length + 1)) == NULL) {
+		sqlite3_result_error_nomem(context);
+		return;
+	}
+	memcpy(copy, v, (size_t)length + 1);
+
+	sqlite3_free(state->best);
+	state->best = copy;
+	state->flags = flags;
+}
+
+static void version_aggregate_final(sqlite3_context* context) {
+	aggregate_state_t* state = sqlite3_aggregate_context(context, 0);
+
+	if (state == NULL || state->best == NULL)
+		return;
+
+	sqlite3_result_text(context, state->best, -1, sqlite3_free);
+	state->best = NULL;
+}
+
+static int max_direction = 1;
+static int min_direction = -1;
+
+#ifdef _WIN32
+__declspec(dllexport)
+#endif
+int sqlite3_versionsqlite_init(sqlite3* db, char** error, const sqlite3_api_routines* api) {
+	int rc = SQLITE_OK;
+
+	SQLITE_EXTENSION_INIT2(api);
+	(void)error;
+
+	if (rc == SQLITE_OK)
+		rc = sqlite3_create_collation(db, "VERSION", SQLITE_UTF8, NULL, version_collation);
+	if (rc == SQLITE_OK)
+		rc = sqlite3_create_function(db, "version_compare", 2, FUNCTION_FLAGS, NULL, version_compare_function, NULL, NULL);
+	if (rc == SQLITE_OK)
+		rc = sqlite3_create_function(db, "version_compare", 4, FUNCTION_FLAGS, NULL, version_compare_function, NULL, NULL);
+	if (rc == SQLITE_OK)
+		rc = sqlite3_create_function(db, "version_key", 1, FUNCTION_FLAGS, NULL, version_key_function, NULL, NULL);
+	if (rc == SQLITE_OK)
+		rc = sqlite3_create_function(db, "version_key", 2, FUNCTION_FLAGS, NULL, version_key_function, NULL, NULL);
+	if (rc == SQLITE_OK)
+		rc = sqlite3_create_function(db, "version_max", 1, FUNCTION_FLAGS, &max_direction, NULL, version_aggregate_step, version_aggregate_final);
+	if (rc == SQLITE_OK)
+		rc = sqlite3_create_function(db, "version_max", 2, FUNCTION_FLAGS, &max_direction, NULL, version_aggregate_step, version_aggregate_final);
+	if (rc == SQLITE_OK)
+		rc = sqlite3_create_function(db, "version_min", 1, FUNCTION_FLAGS, &min_direction, NULL, version_aggregate_step, version_aggregate_final);
+	if (rc == SQLITE_OK)
+		rc = sqlite3_create_function(db, "version_min", 2, FUNCTION_FLAGS, &min_direction, NULL, version_aggregate_step, version_aggregate_final);
+
+	return rc;
+}
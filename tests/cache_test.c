@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#define LIBVERSION_NO_DEPRECATED /* disable deprecated APIs */
+
+#include <libversion/cache.h>
+#include <libversion/version.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+static const char* versions[] = {
+	"", "0", "1", "1.0", "1.0.0", "1.0alpha1", "1.0a", "1.0.a", "1.0p1", "1.0patch1",
+	"1.0.1", "2.0", "10", "20190101", "99999999999999999999999999999", "1.0rc1", "1.0beta2",
+	"0.9.8za", "a", "z", "1.2.3.4.5.6.7.8.9.10", "1..2", "1-2", "1_2_3",
+};
+
+static const int all_flags[] = {
+	0, VERSIONFLAG_P_IS_PATCH, VERSIONFLAG_ANY_IS_PATCH, VERSIONFLAG_LOWER_BOUND, VERSIONFLAG_UPPER_BOUND,
+};
+
+#define COUNT(a) (sizeof(a)/sizeof(a[0]))
+
+static int compare_all(version_cache_t* cache, size_t* comparisons) {
+	size_t i, j, f1, f2;
+	int errors = 0;
+
+	for (i = 0; i < COUNT(versions); i++) {
+		for (j = 0; j < COUNT(versions); j++) {
+			for (f1 = 0; f1 < COUNT(all_flags); f1++) {
+				for (f2 = 0; f2 < COUNT(all_flags); f2++) {
+					int expected = version_compare4(versions[i], versions[j], all_flags[f1], all_flags[f2]);
+					int result = version_cache_compare4(cache, versions[i], versions[j], all_flags[f1], all_flags[f2]);
+					if (result != expected) {
+						fprintf(stderr, "[FAIL] \"%s\" (0x%x) vs \"%s\" (0x%x): expected %d, got %d\n", versions[i], all_flags[f1], versions[j], all_flags[f2], expected, result);
+						errors++;
+					}
+					(*comparisons)++;
+				}
+			}
+		}
+	}
+
+	return errors;
+}
+
+static int check(int condition, const char* what) {
+	fprintf(stderr, "[%s] %s\n", condition ? " OK " : "FAIL", what);
+	return !condition;
+}
+
+#ifndef _WIN32
+typedef struct {
+	version_cache_t* cache;
+	unsigned seed;
+	int errors;
+} thread_data_t;
+
+static void* thread_main(void* arg) {
+	thread_data_t* data = (thread_data_t*)arg;
+	size_t i;
+
+	for (i = 0; i < 100000; i++) {
+		const char* v1 = versions[rand_r(&data->seed) % COUNT(versions)];
+		const char* v2 = versions[rand_r(&data->seed) % COUNT(versions)];
+		int flags = all_flags[rand_r(&data->seed) % COUNT(all_flags)];
+
+		if (version_cache_compare4(data->cache, v1, v2, flags, 0) != version_compare4(v1, v2, flags, 0))
+			data->errors++;
+	}
+
+	return NULL;
+}
+
+static int check_threads(version_cache_t* cache) {
+	pthread_t threads[8];
+	thread_data_t data[8];
+	size_t i;
+	int errors = 0;
+
+	for (i = 0; i < 8; i++) {
+		data[i].cache = cache;
+		data[i].seed = (unsigned)i;
+		data[i].errors = 0;
+		pthread_create(&threads[i], NULL, thread_main, &data[i]);
+	}
+
+	for (i = 0; i < 8; i++) {
+		pthread_join(threads[i], NULL);
+		errors += data[i].errors;
+	}
+
+	return check(errors == 0, "concurrent comparisons are correct");
+}
+
+static int check_processes(version_cache_t* cache) {
+	pid_t children[4];
+	size_t i, comparisons = 0;
+	int errors = 0, status;
+
+	for (i = 0; i < 4; i++) {
+		if ((children[i] = fork()) == 0)
+			_exit(compare_all(cache, &comparisons) != 0);
+	}
+
+	for (i = 0; i < 4; i++) {
+		if (children[i] == -1 || waitpid(children[i], &status, 0) == -1 || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+			errors++;
+	}
+
+	return check(errors == 0, "comparisons in child processes are correct");
+}
+
+/* makes every cached entry point outside of the file or claim a key
+ * longer than the file; relies on the layout in private/shared_cache.c:
+ * slot count at byte 16 of the header, slots right after 48 byte header */
+static int corrupt_shared_cache(const char* path) {
+	FILE* file;
+	unsigned char* data;
+	uint64_t num_slots, slot, i;
+	uint32_t key_length = 0x7fffffff;
+	long size;
+	int ok = 0;
+
+	if ((file = fopen(path, "r+b")) == NULL)
+		return 0;
+
+	if (fseek(file, 0, SEEK_END) != 0 || (size = ftell(file)) <= 0 || fseek(file, 0, SEEK_SET) != 0 || (data = malloc((size_t)size)) == NULL) {
+		fclose(file);
+		return 0;
+	}
+
+	if (fread(data, (size_t)size, 1, file) == 1) {
+		memcpy(&num_slots, data + 16, sizeof(num_slots));
+		for (i = 0; i < num_slots && 48 + (i + 1) * sizeof(slot) <= (uint64_t)size; i++) {
+			memcpy(&slot, data + 48 + i * sizeof(slot), sizeof(slot));
+			if (slot == 0)
+				continue;
+			if (i % 2 == 0) {
+				slot = (slot & 0xffffffff00000000) | ((uint64_t)size / 8 - 1);
+				memcpy(data + 48 + i * sizeof(slot), &slot, sizeof(slot));
+			} else if ((slot & 0xffffffff) * 8 + 8 <= (uint64_t)size) {
+				memcpy(data + (slot & 0xffffffff) * 8 + 4, &key_length, sizeof(key_length));
+			}
+			ok = 1;
+		}
+		ok = ok && fseek(file, 0, SEEK_SET) == 0 && fwrite(data, (size_t)size, 1, file) == 1;
+	}
+
+	free(data);
+	return fclose(file) == 0 && ok;
+}
+#endif
+
+int main(void) {
+	version_cache_t* cache;
+	version_cache_stats_t stats;
+	size_t comparisons = 0;
+	int errors = 0;
+
+	fprintf(stderr, "Test group: large cache\n");
+	cache = version_cache_create(1024 * 1024);
+	errors += check(compare_all(cache, &comparisons) == 0, "results match version_compare4");
+	version_cache_get_stats(cache, &stats);
+	errors += check(stats.hits + stats.misses == comparisons * 2, "every lookup is counted");
+	errors += check(stats.misses == COUNT(versions) * COUNT(all_flags), "each version is parsed once per flags");
+	errors += check(stats.evictions == 0, "nothing is evicted");
+	errors += check(stats.entries == COUNT(versions) * COUNT(all_flags), "all versions are cached");
+	errors += check(stats.memory_usage <= 1024 * 1024, "memory limit is respected");
+	version_cache_free(cache);
+
+	fprintf(stderr, "\nTest group: small cache\n");
+	comparisons = 0;
+	cache = version_cache_create(4096);
+	errors += check(compare_all(cache, &comparisons) == 0, "results match version_compare4");
+	version_cache_get_stats(cache, &stats);
+	errors += check(stats.hits + stats.misses == comparisons * 2, "every lookup is counted");
+	errors += check(stats.evictions > 0, "entries are evicted");
+	errors += check(stats.memory_usage <= 4096, "memory limit is respected");
+	version_cache_free(cache);
+
+	fprintf(stderr, "\nTest group: zero sized cache\n");
+	comparisons = 0;
+	cache = version_cache_create(0);
+	errors += check(compare_all(cache, &comparisons) == 0, "results match version_compare4");
+	version_cache_get_stats(cache, &stats);
+	errors += check(stats.entries == 0 && stats.hits == 0, "nothing is cached");
+	errors += check(stats.memory_usage <= VERSIONCACHE_MIN_MEMORY_LIMIT, "minimal memory limit is respected");
+	version_cache_free(cache);
+
+#ifndef _WIN32
+	fprintf(stderr, "\nTest group: threads\n");
+	cache = version_cache_create(8192);
+	errors += check_threads(cache);
+	version_cache_get_stats(cache, &stats);
+	errors += check(stats.hits + stats.misses == 8 * 100000 * 2, "every lookup is counted");
+	errors += check(stats.memory_usage <= 8192, "memory limit is respected");
+	version_cache_free(cache);
+
+	fprintf(stderr, "\nTest group: shared cache\n");
+	comparisons = 0;
+	cache = version_cache_create_shared(NULL, 1024 * 1024);
+	errors += check(cache != NULL, "cache created");
+	errors += check_processes(cache);
+	errors += check(compare_all(cache, &comparisons) == 0, "results match version_compare4");
+	version_cache_get_stats(cache, &stats);
+	errors += check(stats.hits == comparisons * 2 && stats.misses == 0, "cache was warmed up by children");
+	errors += check(stats.entries == COUNT(versions) * COUNT(all_flags), "all versions are cached once");
+	version_cache_free(cache);
+
+	fprintf(stderr, "\nTest group: small shared cache\n");
+	comparisons = 0;
+	cache = version_cache_create_shared(NULL, 0);
+	errors += check(compare_all(cache, &comparisons) == 0, "results match version_compare4");
+	version_cache_get_stats(cache, &stats);
+	errors += check(stats.entries < COUNT(versions) * COUNT(all_flags), "not all versions fit");
+	errors += check(stats.memory_usage <= 4096, "memory limit is respected");
+	version_cache_free(cache);
+
+	fprintf(stderr, "\nTest group: file backed shared cache\n");
+	{
+		version_cache_t* other;
+		const char* path = "cache_test.shm";
+
+		unlink(path);
+		comparisons = 0;
+		cache = version_cache_create_shared(path, 1024 * 1024);
+		other = version_cache_create_shared(path, 0);
+		errors += check(cache != NULL && other != NULL, "cache created and attached");
+		errors += check(compare_all(cache, &comparisons) == 0, "results match version_compare4");
+		errors += check(compare_all(other, &comparisons) == 0, "results match version_compare4 in attached cache");
+		version_cache_get_stats(other, &stats);
+		errors += check(stats.misses == 0, "attached cache sees all entries");
+		version_cache_free(other);
+		version_cache_free(cache);
+		unlink(path);
+	}
+
+	fprintf(stderr, "\nTest group: corrupt shared cache file\n");
+	{
+		const char* path = "cache_test.shm";
+
+		unlink(path);
+		comparisons = 0;
+		cache = version_cache_create_shared(path, 65536);
+		errors += check(compare_all(cache, &comparisons) == 0, "results match version_compare4");
+		version_cache_free(cache);
+
+		errors += check(corrupt_shared_cache(path), "cache file corrupted");
+
+		cache = version_cache_create_shared(path, 0);
+		errors += check(cache != NULL, "corrupt cache attached");
+		errors += check(compare_all(cache, &comparisons) == 0, "results match version_compare4");
+		version_cache_free(cache);
+		unlink(path);
+	}
+#endif
+
+	return errors != 0;
+}
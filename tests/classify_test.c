@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <libversion/version.h>
+
+#include <stdio.h>
+
+enum {
+	PRE = VERSIONCLASS_PRE_RELEASE,
+	ZERO = VERSIONCLASS_ZERO,
+	POST = VERSIONCLASS_POST_RELEASE,
+	NONZERO = VERSIONCLASS_NONZERO,
+	LETTER = VERSIONCLASS_LETTER_SUFFIX,
+	UNKNOWN = VERSIONCLASS_UNKNOWN_KEYWORD,
+};
+
+static int classify_test(const char* v, int flags, int expected_classes, size_t expected_components) {
+	version_class_t result;
+
+	version_classify(v, flags, &result);
+
+	if (result.classes == expected_classes && result.components == expected_components) {
+		fprintf(stderr, "[ OK ] \"%s\" (0x%x): 0x%02x, %d components\n", v, flags, expected_classes, (int)expected_components);
+		return 0;
+	} else {
+		fprintf(stderr, "[FAIL] \"%s\" (0x%x): expected 0x%02x, %d components, got 0x%02x, %d components\n", v, flags, expected_classes, (int)expected_components, result.classes, (int)result.components);
+		return 1;
+	}
+}
+
+int main(void) {
+	int errors = 0;
+
+	fprintf(stderr, "Test group: numbers\n");
+	errors += classify_test("", 0, 0, 0);
+	errors += classify_test("...", 0, 0, 0);
+	errors += classify_test("0", 0, ZERO, 1);
+	errors += classify_test("1.0", 0, NONZERO|ZERO, 2);
+	errors += classify_test("1.2.3.", 0, NONZERO, 3);
+	errors += classify_test("0001.00", 0, NONZERO|ZERO, 2);
+
+	fprintf(stderr, "\nTest group: keywords\n");
+	errors += classify_test("1.0alpha1", 0, NONZERO|ZERO|PRE, 4);
+	errors += classify_test("1.0-rc.2", 0, NONZERO|ZERO|PRE, 4);
+	errors += classify_test("1.0.post1", 0, NONZERO|ZERO|POST, 4);
+	errors += classify_test("1.0patch", 0, NONZERO|ZERO|POST, 3);
+	errors += classify_test("1.0pl1", 0, NONZERO|ZERO|POST, 4);
+	errors += classify_test("1.0p1", 0, NONZERO|ZERO|PRE|UNKNOWN, 4);
+	errors += classify_test("1.0p1", VERSIONFLAG_P_IS_PATCH, NONZERO|ZERO|POST, 4);
+
+	fprintf(stderr, "\nTest group: unknown keywords\n");
+	errors += classify_test("1.0snapshot20200101", 0, NONZERO|ZERO|PRE|UNKNOWN, 4);
+	errors += classify_test("1.0.git.abc", 0, NONZERO|ZERO|PRE|UNKNOWN, 4);
+	errors += classify_test("1.0foo1", VERSIONFLAG_ANY_IS_PATCH, NONZERO|ZERO|POST|UNKNOWN, 4);
+	errors += classify_test("1a1", 0, NONZERO|PRE|UNKNOWN, 3);
+
+	fprintf(stderr, "\nTest group: letter suffixes\n");
+	errors += classify_test("1.0a", 0, NONZERO|ZERO|LETTER, 3);
+	errors += classify_test("1.0a.1", 0, NONZERO|ZERO|LETTER, 4);
+	errors += classify_test("1.0beta", 0, NONZERO|ZERO|PRE, 3);
+	errors += classify_test("1.0errata", 0, NONZERO|ZERO|POST, 3);
+
+	fprintf(stderr, "\nTest group: bound flags\n");
+	errors += classify_test("1.0", VERSIONFLAG_LOWER_BOUND, NONZERO|ZERO, 2);
+	errors += classify_test("1.0", VERSIONFLAG_UPPER_BOUND, NONZERO|ZERO, 2);
+
+	return errors != 0;
+}
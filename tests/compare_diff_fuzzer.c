@@ -0,0 +1,321 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#define LIBVERSION_NO_DEPRECATED /* disable deprecated APIs */
+
+#include <libversion/cache.h>
+#include <libversion/hardened.h>
+#include <libversion/keywords.h>
+#include <libversion/version.h>
+#include <libversion/version_inline.h>
+#include <libversion/private/random.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Differential fuzzer: checks that all comparison entry points agree
+ * with version_compare4(), and that comparison is antisymmetric and
+ * transitive.
+ *
+ * Input is a line of up to 3 flag characters (low 4 bits of each are
+ * used as flags) followed by up to 3 lines with versions, see corpus
+ * in corpus/compare_diff, which is seeded from compare_test.c. Limits
+ * for hardened comparison are derived from a hash of the whole input.
+ *
+ * Build with -DLIBVERSION_LIBFUZZER=ON for libFuzzer. Otherwise, this
+ * is a standalone program which runs given files (or stdin, which is
+ * suitable for AFL) along with a number of deterministic mutations of
+ * each. */
+
+#define NUM_VERSIONS 3
+#define MAX_VERSION_LENGTH 256
+#define NUM_MUTATIONS 64
+
+typedef struct {
+	char versions[NUM_VERSIONS][MAX_VERSION_LENGTH + 1];
+	int flags[NUM_VERSIONS];
+	version_limits_t limits;
+} input_t;
+
+static version_cache_t* cache;
+static version_cache_t* shared_cache;
+static version_keywords_t* default_keywords;
+
+static int sign(int v) {
+	return (v > 0) - (v < 0);
+}
+
+static void parse_input(const uint8_t* data, size_t size, input_t* input) {
+	size_t pos = 0, i, len;
+	uint64_t hash = 0x811c9dc5; /* 32 bit FNV-1a, see private/hash.h */
+
+	memset(input, 0, sizeof(input_t));
+
+	for (i = 0; i < size; i++)
+		hash = ((hash ^ data[i]) * 0x01000193) & 0xffffffff;
+
+	/* zero (unlimited) in a quarter of cases, small enough to be hit otherwise */
+	input->limits.max_bytes = (hash & 0x3) ? (hash >> 2) % 32 : 0;
+	input->limits.max_components = ((hash >> 8) & 0x3) ? (hash >> 10) % 8 : 0;
+
+	for (i = 0; pos < size && data[pos] != '\n'; pos++, i++)
+		if (i < NUM_VERSIONS)
+			input->flags[i] = data[pos] & 0x0f;
+
+	for (i = 0; i < NUM_VERSIONS && pos < size; i++) {
+		pos++; /* skip newline */
+		for (len = 0; pos < size && data[pos] != '\n'; pos++)
+			if (len < MAX_VERSION_LENGTH)
+				input->versions[i][len++] = (char)data[pos];
+	}
+}
+
+static void fail(const input_t* input, const char* what) {
+	size_t i;
+
+	fprintf(stderr, "[FAIL] %s\n", what);
+	for (i = 0; i < NUM_VERSIONS; i++)
+		fprintf(stderr, "       \"%s\" (0x%x)\n", input->versions[i], input->flags[i]);
+
+	abort();
+}
+
+static int compare_key_bytes(const unsigned char* k1, size_t k1_len, const unsigned char* k2, size_t k2_len) {
+	int res;
+
+	if ((res = memcmp(k1, k2, k1_len < k2_len ? k1_len : k2_len)) != 0)
+		return sign(res);
+
+	return (k1_len > k2_len) - (k1_len < k2_len);
+}
+
+static int compare_keys(const char* v1, const char* v2, int flags1, int flags2) {
+	unsigned char k1[MAX_VERSION_LENGTH * 4], k2[MAX_VERSION_LENGTH * 4];
+	size_t k1_len = version_sort_key(v1, flags1, k1, sizeof(k1));
+	size_t k2_len = version_sort_key(v2, flags2, k2, sizeof(k2));
+
+	if (k1_len > sizeof(k1) || k2_len > sizeof(k2))
+		abort(); /* key is never that long */
+
+	return compare_key_bytes(k1, k1_len, k2, k2_len);
+}
+
+static int compare_hardened_keys(const version_limits_t* limits, const char* v1, const char* v2, int flags1, int flags2) {
+	unsigned char k1[MAX_VERSION_LENGTH * 4 + 1], k2[MAX_VERSION_LENGTH * 4 + 1];
+	size_t k1_len = version_hardened_sort_key(limits, v1, flags1, k1, sizeof(k1));
+	size_t k2_len = version_hardened_sort_key(limits, v2, flags2, k2, sizeof(k2));
+
+	if (k1_len > sizeof(k1) || k2_len > sizeof(k2))
+		abort(); /* key is never that long */
+
+	return compare_key_bytes(k1, k1_len, k2, k2_len);
+}
+
+static void check_pair(const input_t* input, size_t i1, size_t i2) {
+	const char* v1 = input->versions[i1];
+	const char* v2 = input->versions[i2];
+	int flags1 = input->flags[i1], flags2 = input->flags[i2];
+	int expected = version_compare4(v1, v2, flags1, flags2);
+	int hardened_expected;
+	uint64_t a1, a2;
+	const version_limits_t unlimited = { 0, 0 };
+
+	if (expected < -1 || expected > 1)
+		fail(input, "version_compare4 result is out of range");
+
+	if (flags1 == 0 && flags2 == 0 && version_compare2(v1, v2) != expected)
+		fail(input, "version_compare2 disagrees");
+
+	if (version_compare4_inline(v1, v2, flags1, flags2) != expected)
+		fail(input, "version_compare4_inline disagrees");
+
+	if (version_keywords_compare4(NULL, v1, v2, flags1, flags2) != expected)
+		fail(input, "version_keywords_compare4 with built-in keywords disagrees");
+
+	if (version_keywords_compare4(default_keywords, v1, v2, flags1, flags2) != expected)
+		fail(input, "version_keywords_compare4 with default profile disagrees");
+
+	if (version_compare4(v2, v1, flags2, flags1) != -expected)
+		fail(input, "comparison is not antisymmetric");
+
+	if (version_cache_compare4(cache, v1, v2, flags1, flags2) != expected)
+		fail(input, "version_cache_compare4 disagrees");
+
+	if (shared_cache != NULL && version_cache_compare4(shared_cache, v1, v2, flags1, flags2) != expected)
+		fail(input, "version_cache_compare4 with shared cache disagrees");
+
+	if (compare_keys(v1, v2, flags1, flags2) != expected)
+		fail(input, "version_sort_key disagrees");
+
+	/* abbreviated keys may be equal for different versions, but otherwise must be ordered */
+	a1 = version_abbreviated_key(v1, flags1);
+	a2 = version_abbreviated_key(v2, flags2);
+	if (a1 != a2 && (a1 > a2) - (a1 < a2) != expected)
+		fail(input, "version_abbreviated_key disagrees");
+
+	if (version_hardened_compare4(&unlimited, v1, v2, flags1, flags2) != expected)
+		fail(input, "version_hardened_compare4 without limits disagrees");
+
+	hardened_expected = version_hardened_compare4(&input->limits, v1, v2, flags1, flags2);
+
+	if (version_hardened_compare4(&input->limits, v2, v1, flags2, flags1) != -hardened_expected)
+		fail(input, "hardened comparison is not antisymmetric");
+
+	if (compare_hardened_keys(&input->limits, v1, v2, flags1, flags2) != hardened_expected)
+		fail(input, "version_hardened_sort_key disagrees");
+}
+
+static void check_input(const input_t* input) {
+	size_t i, j, k;
+	int ij, jk, ik;
+
+	for (i = 0; i < NUM_VERSIONS; i++)
+		for (j = 0; j < NUM_VERSIONS; j++)
+			check_pair(input, i, j);
+
+	for (i = 0; i < NUM_VERSIONS; i++) {
+		for (j = 0; j < NUM_VERSIONS; j++) {
+			for (k = 0; k < NUM_VERSIONS; k++) {
+				ij = version_compare4(input->versions[i], input->versions[j], input->flags[i], input->flags[j]);
+				jk = version_compare4(input->versions[j], input->versions[k], input->flags[j], input->flags[k]);
+				ik = version_compare4(input->versions[i], input->versions[k], input->flags[i], input->flags[k]);
+
+				if (ij <= 0 && jk <= 0 && ik > 0)
+					fail(input, "comparison is not transitive");
+				if (ij == 0 && jk == 0 && ik != 0)
+					fail(input, "equality is not transitive");
+			}
+		}
+	}
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+	input_t input;
+
+	if (cache == NULL) {
+		/* small enough for evictions to happen */
+		if ((cache = version_cache_create(16384)) == NULL)
+			abort();
+		shared_cache = version_cache_create_shared(NULL, 65536);
+		if ((default_keywords = version_keywords_build(NULL, 0, VERSIONKEYWORDS_DEFAULT)) == NULL)
+			abort();
+	}
+
+	parse_input(data, size, &input);
+	check_input(&input);
+
+	return 0;
+}
+
+#ifndef LIBVERSION_LIBFUZZER
+/* replaces, inserts or removes random bytes, preferring ones which matter for parsing */
+static size_t mutate(uint8_t* data, size_t size, size_t capacity, uint64_t* state) {
+	static const char interesting[] = "0123456789.-_+~ apPrRcCbBeEtTlLhHzZ\n\xff";
+	size_t count = 1 + next_random(state) % 4, pos;
+
+	for (; count > 0; count--) {
+		uint8_t byte = (uint8_t)interesting[next_random(state) % (sizeof(interesting) - 1)];
+		pos = size ? next_random(state) % size : 0;
+
+		switch (next_random(state) % 3) {
+		case 0:
+			if (size > 0)
+				data[pos] = byte;
+			break;
+		case 1:
+			if (size < capacity) {
+				memmove(data + pos + 1, data + pos, size - pos);
+				data[pos] = byte;
+				size++;
+			}
+			break;
+		default:
+			if (size > 0) {
+				memmove(data + pos, data + pos + 1, size - pos - 1);
+				size--;
+			}
+		}
+	}
+
+	return size;
+}
+
+static int run_input(const uint8_t* data, size_t size) {
+	uint8_t mutated[4096];
+	uint64_t state = 0x9e3779b97f4a7c15ULL ^ size;
+	size_t i, mutated_size;
+
+	LLVMFuzzerTestOneInput(data, size);
+
+	for (i = 0; i < NUM_MUTATIONS; i++) {
+		mutated_size = size < sizeof(mutated) ? size : sizeof(mutated);
+		memcpy(mutated, data, mutated_size);
+		mutated_size = mutate(mutated, mutated_size, sizeof(mutated), &state);
+		LLVMFuzzerTestOneInput(mutated, mutated_size);
+	}
+
+	return 1 + NUM_MUTATIONS;
+}
+
+static int run_file(FILE* f, const char* name) {
+	uint8_t data[4096];
+	size_t size = fread(data, 1, sizeof(data), f);
+
+	if (ferror(f)) {
+		fprintf(stderr, "[FAIL] cannot read %s\n", name);
+		return 0;
+	}
+
+	return run_input(data, size);
+}
+
+int main(int argc, char** argv) {
+	int i, inputs = 0;
+	FILE* f;
+
+	if (argc < 2) {
+		inputs += run_file(stdin, "stdin");
+	}
+
+	for (i = 1; i < argc; i++) {
+		if ((f = fopen(argv[i], "rb")) == NULL) {
+			fprintf(stderr, "[FAIL] cannot open %s\n", argv[i]);
+			return 1;
+		}
+		inputs += run_file(f, argv[i]);
+		fclose(f);
+	}
+
+	fprintf(stderr, "[ OK ] %d inputs\n", inputs);
+
+	version_cache_free(cache);
+	if (shared_cache != NULL)
+		version_cache_free(shared_cache);
+	version_keywords_free(default_keywords);
+
+	return 0;
+}
+#endif
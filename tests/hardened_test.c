@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <libversion/hardened.h>
+#include <libversion/version.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#define COUNT(a) (sizeof(a)/sizeof(a[0]))
+#define MY_MIN(a, b) ((a) < (b) ? (a) : (b))
+
+static const int all_flags[] = {
+	0,
+	VERSIONFLAG_P_IS_PATCH,
+	VERSIONFLAG_LOWER_BOUND,
+	VERSIONFLAG_UPPER_BOUND,
+};
+
+/* with limits of 12 bytes and 4 components, includes versions
+ * which are exactly at and just over each of the limits */
+static const char* samples[] = {
+	"", "0", "1", "1.0", "1.0a", "1.0alpha1", "1.0.1", "1.2.3.4", "1.2.3.4.5", "1.2.3.4a",
+	"1.2.3a", "1.2.3a.1", "1.2.3alpha", "1.2.3.0.0.1", "a.b.c.d.e", "00000000001",
+	"123456789012", "1234567890123", "1234567890124", "123456789012345",
+	"1.2.3.4.5.6.", "1.2.3.4.5.6.7", "............", ".............", "0000000000000",
+};
+
+static int sign(int v) {
+	return (v > 0) - (v < 0);
+}
+
+static int compare_keys(const version_limits_t* limits, const char* v1, const char* v2, int flags1, int flags2) {
+	unsigned char k1[128], k2[128];
+	size_t k1_len = version_hardened_sort_key(limits, v1, flags1, k1, sizeof(k1));
+	size_t k2_len = version_hardened_sort_key(limits, v2, flags2, k2, sizeof(k2));
+	int res = memcmp(k1, k2, MY_MIN(k1_len, k2_len));
+
+	if (memchr(k1, 0, k1_len) != NULL || memchr(k2, 0, k2_len) != NULL)
+		return 2; /* never equal to comparison result */
+
+	return res != 0 ? sign(res) : (k1_len > k2_len) - (k1_len < k2_len);
+}
+
+static int compare_test(const version_limits_t* limits, const char* v1, const char* v2, int expected) {
+	int result = version_hardened_compare4(limits, v1, v2, 0, 0);
+	int reverse = version_hardened_compare4(limits, v2, v1, 0, 0);
+
+	if (result == expected && reverse == -expected && compare_keys(limits, v1, v2, 0, 0) == expected) {
+		fprintf(stderr, "[ OK ] \"%s\" vs \"%s\": %d\n", v1, v2, expected);
+		return 0;
+	} else {
+		fprintf(stderr, "[FAIL] \"%s\" vs \"%s\": expected %d, got %d (reverse %d)\n", v1, v2, expected, result, reverse);
+		return 1;
+	}
+}
+
+int main(void) {
+	const version_limits_t unlimited = { 0, 0 };
+	const version_limits_t limits = { 12, 4 };
+	size_t i, j, k, if1, if2, if3;
+	int errors = 0, group_errors, checks = 0;
+
+	fprintf(stderr, "Test group: no limits\n");
+	for (i = 0; i < COUNT(samples); i++) {
+		for (j = 0; j < COUNT(samples); j++) {
+			for (if1 = 0; if1 < COUNT(all_flags); if1++) {
+				for (if2 = 0; if2 < COUNT(all_flags); if2++) {
+					int expected = version_compare4(samples[i], samples[j], all_flags[if1], all_flags[if2]);
+					if (version_hardened_compare4(&unlimited, samples[i], samples[j], all_flags[if1], all_flags[if2]) != expected) {
+						fprintf(stderr, "[FAIL] \"%s\" (0x%x) vs \"%s\" (0x%x): differs from version_compare4\n", samples[i], all_flags[if1], samples[j], all_flags[if2]);
+						errors++;
+					}
+					checks++;
+				}
+			}
+		}
+	}
+	fprintf(stderr, "[%s] %d comparisons\n", errors ? "FAIL" : " OK ", checks);
+
+	fprintf(stderr, "\nTest group: component limit\n");
+	errors += compare_test(&limits, "1.2.3.4", "1.2.3.4.5", 0);
+	errors += compare_test(&limits, "1.2.3.4", "1.2.3.4a", 0);
+	errors += compare_test(&limits, "1.2.3.4", "1.2.3.4.0.1", 0);
+	errors += compare_test(&limits, "1.2.3a", "1.2.3a.1", 0);
+	errors += compare_test(&limits, "1.2.3", "1.2.3a", -1);
+	errors += compare_test(&limits, "1.2.3.4", "1.2.3.5", -1);
+
+	fprintf(stderr, "\nTest group: byte limit\n");
+	errors += compare_test(&limits, "123456789012", "1234567890123", 1);
+	errors += compare_test(&limits, "1234567890123", "", -1);
+	errors += compare_test(&limits, "1234567890123", "1234567890124", 0);
+	errors += compare_test(&limits, "1234567890123", "123456789013x", -1);
+	errors += compare_test(&limits, "0000000000000", ".............", 1);
+
+	fprintf(stderr, "\nTest group: strict weak ordering\n");
+	group_errors = errors;
+	checks = 0;
+	for (if1 = 0; if1 < COUNT(all_flags); if1++) {
+		for (if2 = 0; if2 < COUNT(all_flags); if2++) {
+			for (i = 0; i < COUNT(samples); i++) {
+				for (j = 0; j < COUNT(samples); j++) {
+					int ij = version_hardened_compare4(&limits, samples[i], samples[j], all_flags[if1], all_flags[if2]);
+
+					if (version_hardened_compare4(&limits, samples[j], samples[i], all_flags[if2], all_flags[if1]) != -ij) {
+						fprintf(stderr, "[FAIL] \"%s\" (0x%x) vs \"%s\" (0x%x): not antisymmetric\n", samples[i], all_flags[if1], samples[j], all_flags[if2]);
+						errors++;
+					}
+					if (compare_keys(&limits, samples[i], samples[j], all_flags[if1], all_flags[if2]) != ij) {
+						fprintf(stderr, "[FAIL] \"%s\" (0x%x) vs \"%s\" (0x%x): keys do not agree with comparison\n", samples[i], all_flags[if1], samples[j], all_flags[if2]);
+						errors++;
+					}
+
+					for (if3 = 0; if3 < COUNT(all_flags); if3 += 3) {
+						for (k = 0; k < COUNT(samples); k++) {
+							int jk = version_hardened_compare4(&limits, samples[j], samples[k], all_flags[if2], all_flags[if3]);
+							int ik = version_hardened_compare4(&limits, samples[i], samples[k], all_flags[if1], all_flags[if3]);
+
+							/* i <= j <= k implies i <= k, with equality only if both are equal */
+							if (ij <= 0 && jk <= 0 && (ik > 0 || (ik == 0 && (ij != 0 || jk != 0)))) {
+								fprintf(stderr, "[FAIL] \"%s\", \"%s\", \"%s\": not transitive\n", samples[i], samples[j], samples[k]);
+								errors++;
+							}
+							checks++;
+						}
+					}
+				}
+			}
+		}
+	}
+	fprintf(stderr, "[%s] %d triples\n", errors != group_errors ? "FAIL" : " OK ", checks);
+
+	return errors != 0;
+}
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#define LIBVERSION_NO_DEPRECATED /* disable deprecated APIs */
+
+#include <libversion/version.h>
+#include <libversion/private/key.h>
+
+#include <stdio.h>
+#include <string.h>
+
+/* Checks that comparing keys gives the same result as version_compare4()
+ * on exhaustively enumerated short versions and a set of samples. */
+
+static const int all_flags[] = {
+	0,
+	VERSIONFLAG_P_IS_PATCH,
+	VERSIONFLAG_ANY_IS_PATCH,
+	VERSIONFLAG_LOWER_BOUND,
+	VERSIONFLAG_UPPER_BOUND,
+	VERSIONFLAG_P_IS_PATCH | VERSIONFLAG_LOWER_BOUND,
+};
+
+static const char* samples[] = {
+	"", "0", "1", "a", "z", "1.0", "1.0.0", "1.0a", "1.0.a", "1alpha1",
+	"1patch1", "1.0.1", "0.0.a", "1.0.0.1", "1.0.0.a",
+	"12345678901234567", "12345678901234568", "123456789012345678",
+};
+
+/* longer than abbreviated keys */
+static const char* long_samples[] = {
+	"20240131", "20240131.1", "20240131.1.2", "20240131.1.3", "20240131.1.2a",
+	"1.2.3.4.5.6.7.8", "1.2.3.4.5.6.7.8.9", "1.2.3.4.5.6.7.8.10", "1.2.3.4.5.6.7.8.0.1",
+	"0.0.0.0.0.0.0.0.0.0.1", "0.0.0.0.0.0.0.0.0.0.0.1", "0.0.0.0.0.0.0.0.0.0.alpha",
+	"1.0alpha1.0.0.0.0.0.1", "1.0alpha1.0.0.0.0.0.2", "1.0patch1.0.0.0.0.0.1",
+	"1234567890123456", "1234567890123456.1", "1234567890123457", "123456789012345678901234567890",
+	"123456789012345678901234567891", "1234567890123456789012345678901",
+};
+
+#define COUNT(a) (sizeof(a)/sizeof(a[0]))
+#define MY_MIN(a, b) ((a) < (b) ? (a) : (b))
+
+static int sign(int v) {
+	return (v > 0) - (v < 0);
+}
+
+static int key_test(const char* v1, const char* v2, int flags1, int flags2) {
+	unsigned char k1[128], k2[128];
+	size_t k1_len = make_version_key(v1, flags1, k1, sizeof(k1));
+	size_t k2_len = make_version_key(v2, flags2, k2, sizeof(k2));
+
+	int expected = version_compare4(v1, v2, flags1, flags2);
+	int result = compare_version_keys(k1, k1_len, k2, k2_len);
+
+	if (sign(result) != sign(expected) || memchr(k1, 0, k1_len) != NULL) {
+		fprintf(stderr, "[FAIL] \"%s\" (0x%x) vs \"%s\" (0x%x): expected %d, got %d\n", v1, flags1, v2, flags2, expected, result);
+		return 1;
+	}
+
+	return 0;
+}
+
+static int abbreviated_key_test(const char* v1, const char* v2, int flags1, int flags2) {
+	unsigned char k1[128];
+	uint64_t a1 = version_abbreviated_key(v1, flags1);
+	uint64_t a2 = version_abbreviated_key(v2, flags2);
+	size_t k1_len = make_version_key(v1, flags1, k1, sizeof(k1));
+
+	int expected = version_compare4(v1, v2, flags1, flags2);
+
+	/* differing abbreviated keys must be exact, equal versions must have equal ones */
+	if ((a1 != a2 && (a1 < a2 ? -1 : 1) != expected) || (expected == 0 && a1 != a2)) {
+		fprintf(stderr, "[FAIL] \"%s\" (0x%x) vs \"%s\" (0x%x): expected %d, got abbreviated keys %016llx and %016llx\n", v1, flags1, v2, flags2, expected, (unsigned long long)a1, (unsigned long long)a2);
+		return 1;
+	}
+
+	if (a1 != version_abbreviate_sort_key(k1, k1_len)) {
+		fprintf(stderr, "[FAIL] \"%s\" (0x%x): abbreviated key differs from the one of full key\n", v1, flags1);
+		return 1;
+	}
+
+	return 0;
+}
+
+int main(void) {
+	const char version_chars[] = { '0', '1', 'a', 'P', 'z', '.' };
+	const size_t num_version_chars = COUNT(version_chars);
+
+	char versions[1 + 6 + 36 + 216 + 1296][5];
+	size_t num_versions = 0, len, i, j, if1, if2, pos, code;
+	int errors = 0, checks = 0;
+
+	for (len = 0; len <= 4; len++) {
+		for (code = 0; ; code++) {
+			char buffer[5];
+			size_t c = code;
+			for (pos = 0; pos < len; pos++, c /= num_version_chars)
+				buffer[pos] = version_chars[c % num_version_chars];
+			if (c != 0)
+				break;
+			buffer[len] = '\0';
+			memcpy(versions[num_versions++], buffer, sizeof(buffer));
+		}
+	}
+
+	fprintf(stderr, "Test group: enumerated versions\n");
+	for (i = 0; i < num_versions; i++) {
+		for (j = 0; j < num_versions; j += 31) {
+			for (if1 = 0; if1 < COUNT(all_flags); if1++) {
+				for (if2 = 0; if2 < COUNT(all_flags); if2++) {
+					errors += key_test(versions[i], versions[(j + i) % num_versions], all_flags[if1], all_flags[if2]);
+					checks++;
+				}
+			}
+		}
+	}
+	fprintf(stderr, "[%s] %d comparisons\n", errors ? "FAIL" : " OK ", checks);
+
+	fprintf(stderr, "\nTest group: samples\n");
+	checks = 0;
+	for (i = 0; i < COUNT(samples); i++) {
+		for (j = 0; j < COUNT(samples); j++) {
+			for (if1 = 0; if1 < COUNT(all_flags); if1++) {
+				for (if2 = 0; if2 < COUNT(all_flags); if2++) {
+					errors += key_test(samples[i], samples[j], all_flags[if1], all_flags[if2]);
+					checks++;
+				}
+			}
+		}
+	}
+	fprintf(stderr, "[%s] %d comparisons\n", errors ? "FAIL" : " OK ", checks);
+
+	fprintf(stderr, "\nTest group: canonical versions\n");
+	checks = 0;
+	for (i = 0; i < num_versions; i++) {
+		for (if1 = 0; if1 < 3; if1++) {
+			unsigned char key[128];
+			char canonical[128];
+			size_t key_len = make_version_key(versions[i], all_flags[if1], key, sizeof(key));
+			make_version_from_key(key, key_len, canonical, sizeof(canonical));
+			if (version_compare4(versions[i], canonical, all_flags[if1], all_flags[if1]) != 0) {
+				fprintf(stderr, "[FAIL] \"%s\" (0x%x): canonical form \"%s\" differs\n", versions[i], all_flags[if1], canonical);
+				errors++;
+			}
+			checks++;
+		}
+	}
+	fprintf(stderr, "[%s] %d versions\n", errors ? "FAIL" : " OK ", checks);
+
+	fprintf(stderr, "\nTest group: abbreviated keys\n");
+	checks = 0;
+	for (i = 0; i < num_versions; i++) {
+		for (j = 0; j < num_versions; j += 31) {
+			for (if1 = 0; if1 < COUNT(all_flags); if1++) {
+				errors += abbreviated_key_test(versions[i], versions[(j + i) % num_versions], all_flags[if1], all_flags[(if1 + j) % COUNT(all_flags)]);
+				checks++;
+			}
+		}
+	}
+	for (i = 0; i < COUNT(long_samples); i++) {
+		for (j = 0; j < COUNT(long_samples); j++) {
+			for (if1 = 0; if1 < COUNT(all_flags); if1++) {
+				for (if2 = 0; if2 < COUNT(all_flags); if2++) {
+					errors += abbreviated_key_test(long_samples[i], long_samples[j], all_flags[if1], all_flags[if2]);
+					checks++;
+				}
+			}
+		}
+	}
+	fprintf(stderr, "[%s] %d comparisons\n", errors ? "FAIL" : " OK ", checks);
+
+	fprintf(stderr, "\nTest group: public sort key\n");
+	for (i = 0; i < COUNT(samples); i++) {
+		unsigned char key[128], sort_key[128], short_key[4] = { 0, 0, 0, 0xaa };
+		size_t key_len = make_version_key(samples[i], 0, key, sizeof(key));
+		if (version_sort_key(samples[i], 0, sort_key, sizeof(sort_key)) != key_len || memcmp(key, sort_key, key_len) != 0) {
+			fprintf(stderr, "[FAIL] \"%s\": sort key differs\n", samples[i]);
+			errors++;
+		}
+		if (version_sort_key(samples[i], 0, short_key, 3) != key_len || memcmp(key, short_key, MY_MIN(key_len, 3)) != 0 || short_key[3] != 0xaa) {
+			fprintf(stderr, "[FAIL] \"%s\": truncated sort key is wrong\n", samples[i]);
+			errors++;
+		}
+	}
+	fprintf(stderr, "[%s] %d versions\n", errors ? "FAIL" : " OK ", (int)COUNT(samples));
+
+	return errors != 0;
+}
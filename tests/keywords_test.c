@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <libversion/keywords.h>
+#include <libversion/version.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#define COUNT(a) (sizeof(a)/sizeof(a[0]))
+#define MY_MIN(a, b) ((a) < (b) ? (a) : (b))
+
+static const int all_flags[] = {
+	0,
+	VERSIONFLAG_P_IS_PATCH,
+	VERSIONFLAG_ANY_IS_PATCH,
+	VERSIONFLAG_LOWER_BOUND,
+	VERSIONFLAG_UPPER_BOUND,
+};
+
+static const char* samples[] = {
+	"", "0", "1.0", "1.0.0", "1.0a", "1.0.a", "1.0p", "1.0P1", "1alpha1", "1.0ALPHA",
+	"1.0beta", "1.0rc1", "1.0pre", "1.0preview2", "1.0post1", "1.0postfix", "1.0patch1",
+	"1.0patchset", "1.0pl2", "1.0errata", "1.0pa", "1.0pr", "1.0pos", "1.0foo", "1.0final",
+	"1.0dev1", "1.0snapshot", "1.0.git.abc", "1.0ga", "1.0.1", "1.0-final.1", "1.0gamma",
+};
+
+static int sign(int v) {
+	return (v > 0) - (v < 0);
+}
+
+static int compare_keys(const char* v1, const char* v2, int flags1, int flags2, const version_keywords_t* keywords) {
+	unsigned char k1[128], k2[128];
+	size_t k1_len = version_keywords_sort_key(keywords, v1, flags1, k1, sizeof(k1));
+	size_t k2_len = version_keywords_sort_key(keywords, v2, flags2, k2, sizeof(k2));
+	int res = memcmp(k1, k2, MY_MIN(k1_len, k2_len));
+
+	return res != 0 ? sign(res) : (k1_len > k2_len) - (k1_len < k2_len);
+}
+
+/* checks that all samples compare with keywords the same as with reference
+ * keywords, and that keys agree with comparison */
+static int agreement_test(const version_keywords_t* keywords, const version_keywords_t* reference) {
+	size_t i, j, if1, if2;
+	int errors = 0, checks = 0, result, expected;
+
+	for (i = 0; i < COUNT(samples); i++) {
+		for (j = 0; j < COUNT(samples); j++) {
+			for (if1 = 0; if1 < COUNT(all_flags); if1++) {
+				for (if2 = 0; if2 < COUNT(all_flags); if2++) {
+					const char* v1 = samples[i], *v2 = samples[j];
+					int flags1 = all_flags[if1], flags2 = all_flags[if2];
+
+					result = version_keywords_compare4(keywords, v1, v2, flags1, flags2);
+					expected = reference != NULL ? version_keywords_compare4(reference, v1, v2, flags1, flags2) : version_compare4(v1, v2, flags1, flags2);
+					if (result != expected) {
+						fprintf(stderr, "[FAIL] \"%s\" (0x%x) vs \"%s\" (0x%x): expected %d, got %d\n", v1, flags1, v2, flags2, expected, result);
+						errors++;
+					}
+
+					if (compare_keys(v1, v2, flags1, flags2, keywords) != result) {
+						fprintf(stderr, "[FAIL] \"%s\" (0x%x) vs \"%s\" (0x%x): keys do not agree with comparison\n", v1, flags1, v2, flags2);
+						errors++;
+					}
+
+					checks++;
+				}
+			}
+		}
+	}
+
+	fprintf(stderr, "[%s] %d comparisons\n", errors ? "FAIL" : " OK ", checks);
+	return errors;
+}
+
+static int compare_test(const version_keywords_t* keywords, const char* v1, const char* v2, int flags, int expected) {
+	int result = version_keywords_compare4(keywords, v1, v2, flags, flags);
+
+	if (result == expected && compare_keys(v1, v2, flags, flags, keywords) == expected) {
+		fprintf(stderr, "[ OK ] \"%s\" vs \"%s\" (0x%x): %d\n", v1, v2, flags, expected);
+		return 0;
+	} else {
+		fprintf(stderr, "[FAIL] \"%s\" vs \"%s\" (0x%x): expected %d, got %d\n", v1, v2, flags, expected, result);
+		return 1;
+	}
+}
+
+static int classify_test(const version_keywords_t* keywords, const char* v, int expected_classes) {
+	version_class_t result;
+
+	version_keywords_classify(keywords, v, 0, &result);
+
+	if (result.classes == expected_classes) {
+		fprintf(stderr, "[ OK ] \"%s\": 0x%02x\n", v, expected_classes);
+		return 0;
+	} else {
+		fprintf(stderr, "[FAIL] \"%s\": expected 0x%02x, got 0x%02x\n", v, expected_classes, result.classes);
+		return 1;
+	}
+}
+
+static int invalid_test(const char* keyword, int match, int rank) {
+	version_keyword_t rule = { keyword, match, rank };
+	version_keywords_t* keywords = version_keywords_build(&rule, 1, 0);
+
+	if (keywords == NULL) {
+		fprintf(stderr, "[ OK ] \"%s\" (%d, %d) rejected\n", keyword ? keyword : "(null)", match, rank);
+		return 0;
+	} else {
+		fprintf(stderr, "[FAIL] \"%s\" (%d, %d) accepted\n", keyword ? keyword : "(null)", match, rank);
+		version_keywords_free(keywords);
+		return 1;
+	}
+}
+
+/* distinct pre-release rules along with as many release rules, which are not limited */
+static int too_many_rules_test(size_t count, int expected_ok) {
+	version_keyword_t rules[(VERSIONKEYWORDS_MAX_RANKED + 1) * 2];
+	char names[(VERSIONKEYWORDS_MAX_RANKED + 1) * 2][4];
+	version_keywords_t* keywords;
+	size_t i;
+
+	for (i = 0; i < count * 2; i++) {
+		names[i][0] = 'a' + i % 26;
+		names[i][1] = 'a' + i / 26;
+		names[i][2] = i < count ? 'x' : 'y';
+		names[i][3] = '\0';
+		rules[i].keyword = names[i];
+		rules[i].match = VERSIONKEYWORD_EXACT;
+		rules[i].rank = i < count ? VERSIONKEYWORD_PRE_RELEASE : VERSIONKEYWORD_RELEASE;
+	}
+
+	keywords = version_keywords_build(rules, count * 2, 0);
+
+	if ((keywords != NULL) == expected_ok && (keywords == NULL || version_keywords_compare4(keywords, "1.0aax", "1.0bax", 0, 0) == -1)) {
+		fprintf(stderr, "[ OK ] %d ranked rules %s\n", (int)count, expected_ok ? "accepted" : "rejected");
+		version_keywords_free(keywords);
+		return 0;
+	} else {
+		fprintf(stderr, "[FAIL] %d ranked rules %s\n", (int)count, expected_ok ? "rejected" : "accepted");
+		version_keywords_free(keywords);
+		return 1;
+	}
+}
+
+int main(void) {
+	static const version_keyword_t custom_rules[] = {
+		{ "dev", VERSIONKEYWORD_EXACT, VERSIONKEYWORD_PRE_RELEASE },
+		{ "snapshot", VERSIONKEYWORD_EXACT, VERSIONKEYWORD_PRE_RELEASE },
+		{ "git", VERSIONKEYWORD_EXACT, VERSIONKEYWORD_PRE_RELEASE },
+		{ "Final", VERSIONKEYWORD_EXACT, VERSIONKEYWORD_RELEASE },
+		{ "ga", VERSIONKEYWORD_EXACT, VERSIONKEYWORD_RELEASE },
+		{ "preview", VERSIONKEYWORD_EXACT, VERSIONKEYWORD_POST_RELEASE },
+		{ "postf", VERSIONKEYWORD_PREFIX, VERSIONKEYWORD_PRE_RELEASE },
+		{ "alpha", VERSIONKEYWORD_EXACT, VERSIONKEYWORD_POST_RELEASE },
+	};
+	static const version_keyword_t reversed_default_rules[] = {
+		{ "errata", VERSIONKEYWORD_EXACT, VERSIONKEYWORD_POST_RELEASE },
+		{ "pl", VERSIONKEYWORD_EXACT, VERSIONKEYWORD_POST_RELEASE },
+		{ "patch", VERSIONKEYWORD_PREFIX, VERSIONKEYWORD_POST_RELEASE },
+		{ "post", VERSIONKEYWORD_PREFIX, VERSIONKEYWORD_POST_RELEASE },
+		{ "pre", VERSIONKEYWORD_PREFIX, VERSIONKEYWORD_PRE_RELEASE },
+		{ "rc", VERSIONKEYWORD_EXACT, VERSIONKEYWORD_PRE_RELEASE },
+		{ "beta", VERSIONKEYWORD_EXACT, VERSIONKEYWORD_PRE_RELEASE },
+		{ "alpha", VERSIONKEYWORD_EXACT, VERSIONKEYWORD_PRE_RELEASE },
+	};
+	static const version_keyword_t rc_rules[] = {
+		{ "rc", VERSIONKEYWORD_EXACT, VERSIONKEYWORD_PRE_RELEASE },
+	};
+
+	version_keywords_t* defaults = version_keywords_build(NULL, 0, VERSIONKEYWORDS_DEFAULT);
+	version_keywords_t* explicit_defaults = version_keywords_build(reversed_default_rules, COUNT(reversed_default_rules), 0);
+	version_keywords_t* custom = version_keywords_build(custom_rules, COUNT(custom_rules), VERSIONKEYWORDS_DEFAULT);
+	version_keywords_t* empty = version_keywords_build(NULL, 0, 0);
+	version_keywords_t* rc_first = version_keywords_build(rc_rules, COUNT(rc_rules), VERSIONKEYWORDS_DEFAULT);
+	int errors = 0;
+
+	if (defaults == NULL || explicit_defaults == NULL || custom == NULL || empty == NULL) {
+		fprintf(stderr, "[FAIL] cannot build keywords\n");
+		return 1;
+	}
+
+	fprintf(stderr, "Test group: default keywords\n");
+	errors += agreement_test(NULL, NULL);
+	errors += agreement_test(defaults, NULL);
+
+	fprintf(stderr, "\nTest group: custom keywords\n");
+	errors += compare_test(custom, "1.0final", "1.0", 0, 0);
+	errors += compare_test(custom, "1.0-FINAL", "1.0.0", 0, 0);
+	errors += compare_test(custom, "1.0ga", "1.0", 0, 0);
+	errors += compare_test(custom, "1.0-final.1", "1.0.0.1", 0, 0);
+	errors += compare_test(custom, "1.0final", "1.0.1", 0, -1);
+	errors += compare_test(custom, "1.0dev1", "1.0", 0, -1);
+	errors += compare_test(custom, "1.0snapshot", "1.0", VERSIONFLAG_ANY_IS_PATCH, -1);
+	errors += compare_test(custom, "1.0.git.abc", "1.0", VERSIONFLAG_ANY_IS_PATCH, -1);
+	errors += compare_test(custom, "1.0gamma", "1.0", VERSIONFLAG_ANY_IS_PATCH, 1);
+
+	fprintf(stderr, "\nTest group: rule priority\n");
+	errors += compare_test(custom, "1.0preview", "1.0", 0, 1);    /* exact rule over prefix */
+	errors += compare_test(custom, "1.0prefix", "1.0", 0, -1);
+	errors += compare_test(custom, "1.0postfix", "1.0", 0, -1);   /* longer prefix rule */
+	errors += compare_test(custom, "1.0postal", "1.0", 0, 1);
+	errors += compare_test(custom, "1.0alpha", "1.0", 0, 1);      /* own rules over defaults */
+	errors += compare_test(custom, "1.0p1", "1.0", 0, -1);
+	errors += compare_test(custom, "1.0p1", "1.0", VERSIONFLAG_P_IS_PATCH, 1);
+
+	fprintf(stderr, "\nTest group: rule order\n");
+	errors += agreement_test(custom, custom);
+	errors += agreement_test(explicit_defaults, explicit_defaults);
+	errors += compare_test(explicit_defaults, "1.0pre1", "1.0rc1", 0, -1);   /* as listed */
+	errors += compare_test(explicit_defaults, "1.0rc1", "1.0beta1", 0, -1);
+	errors += compare_test(explicit_defaults, "1.0beta1", "1.0alpha1", 0, -1);
+	errors += compare_test(explicit_defaults, "1.0errata", "1.0pl", 0, -1);
+	errors += compare_test(explicit_defaults, "1.0patch1", "1.0post1", 0, -1);
+	errors += compare_test(explicit_defaults, "1.0preview", "1.0prerelease", 0, 0);
+	errors += compare_test(explicit_defaults, "1.0alpha1", "1.0foo", 0, -1);  /* before unlisted words */
+	errors += compare_test(explicit_defaults, "1.0post1", "1.0foo", VERSIONFLAG_ANY_IS_PATCH, -1);
+	errors += compare_test(custom, "1.0dev1", "1.0alpha1", VERSIONFLAG_ANY_IS_PATCH, -1);
+	errors += compare_test(custom, "1.0dev1", "1.0beta1", 0, -1);         /* before built-in keywords */
+	errors += compare_test(custom, "1.0snapshot1", "1.0git1", 0, -1);
+	errors += compare_test(custom, "1.0git1", "1.0postfix", 0, -1);
+	errors += compare_test(custom, "1.0beta1", "1.0rc1", 0, -1);          /* built-in keywords by first letter */
+	errors += compare_test(custom, "1.0beta1", "1.0foo", 0, -1);
+	errors += too_many_rules_test(VERSIONKEYWORDS_MAX_RANKED, 1);
+	errors += too_many_rules_test(VERSIONKEYWORDS_MAX_RANKED + 1, 0);
+
+	fprintf(stderr, "\nTest group: listed rules before built-in keywords\n");
+	errors += agreement_test(rc_first, rc_first);
+	errors += compare_test(rc_first, "1.0rc1", "1.0alpha1", 0, -1);  /* changes built-in order */
+	errors += compare_test(rc_first, "1.0rc1", "1.0beta1", 0, -1);
+	errors += compare_test(rc_first, "1.0alpha1", "1.0beta1", 0, -1); /* the rest keep it */
+	errors += compare_test(rc_first, "1.0beta1", "1.0pre1", 0, -1);
+	errors += compare_test(rc_first, "1.0pre1", "1.0", 0, -1);
+	errors += compare_test(rc_first, "1.0errata", "1.0patch1", 0, -1);
+
+	fprintf(stderr, "\nTest group: no keywords\n");
+	errors += compare_test(empty, "1.0patch1", "1.0", 0, -1);
+	errors += compare_test(empty, "1.0alpha1", "1.0", VERSIONFLAG_ANY_IS_PATCH, 1);
+	errors += compare_test(empty, "1.0p1", "1.0", VERSIONFLAG_P_IS_PATCH, 1);
+	errors += compare_test(empty, "1.0a", "1.0", 0, 1);
+
+	fprintf(stderr, "\nTest group: classification\n");
+	errors += classify_test(custom, "1.0final", VERSIONCLASS_NONZERO|VERSIONCLASS_ZERO);
+	errors += classify_test(custom, "1.0snapshot1", VERSIONCLASS_NONZERO|VERSIONCLASS_ZERO|VERSIONCLASS_PRE_RELEASE);
+	errors += classify_test(custom, "1.0nightly1", VERSIONCLASS_NONZERO|VERSIONCLASS_ZERO|VERSIONCLASS_PRE_RELEASE|VERSIONCLASS_UNKNOWN_KEYWORD);
+	errors += classify_test(NULL, "1.0snapshot1", VERSIONCLASS_NONZERO|VERSIONCLASS_ZERO|VERSIONCLASS_PRE_RELEASE|VERSIONCLASS_UNKNOWN_KEYWORD);
+
+	fprintf(stderr, "\nTest group: invalid rules\n");
+	errors += invalid_test(NULL, VERSIONKEYWORD_EXACT, VERSIONKEYWORD_PRE_RELEASE);
+	errors += invalid_test("", VERSIONKEYWORD_PREFIX, VERSIONKEYWORD_PRE_RELEASE);
+	errors += invalid_test("rc1", VERSIONKEYWORD_EXACT, VERSIONKEYWORD_PRE_RELEASE);
+	errors += invalid_test("pre-release", VERSIONKEYWORD_EXACT, VERSIONKEYWORD_PRE_RELEASE);
+	errors += invalid_test("dev", 2, VERSIONKEYWORD_PRE_RELEASE);
+	errors += invalid_test("dev", VERSIONKEYWORD_EXACT, 0);
+	errors += invalid_test("dev", VERSIONKEYWORD_EXACT, 4);
+
+	version_keywords_free(defaults);
+	version_keywords_free(explicit_defaults);
+	version_keywords_free(custom);
+	version_keywords_free(empty);
+	version_keywords_free(rc_first);
+	version_keywords_free(NULL);
+
+	return errors != 0;
+}
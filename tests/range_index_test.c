@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#define LIBVERSION_NO_DEPRECATED /* disable deprecated APIs */
+
+#include <libversion/range_index.h>
+#include <libversion/version.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static const char* versions[] = {
+	"", "0", "0.9", "0.99", "1.0alpha1", "1.0beta", "1.0rc1", "1.0", "1.0.0",
+	"1.0patch1", "1.0.1", "1.0a", "1.0.1.0.1", "1.1", "1.1pre2", "1.2", "10",
+	"1.0.0.0.1", "1.0.0.0.a", "20190101", "99999999999999999999", "a", "z",
+};
+
+static const int endpoint_flags[] = {
+	0, VERSIONFLAG_LOWER_BOUND, VERSIONFLAG_UPPER_BOUND, VERSIONFLAG_P_IS_PATCH,
+};
+
+#define COUNT(a) (sizeof(a)/sizeof(a[0]))
+
+#define SHARED_ENDPOINT_RANGES 100000
+#define SHARED_ENDPOINT_QUERIES 2000
+
+typedef struct {
+	unsigned char* matched;
+	size_t count;
+} query_result_t;
+
+static int collect(size_t range, void* userdata) {
+	query_result_t* result = (query_result_t*)userdata;
+	result->matched[range]++;
+	result->count++;
+	return 0;
+}
+
+static int range_contains(const version_range_t* range, const char* v, int flags) {
+	int res;
+
+	if (range->lower != NULL) {
+		res = version_compare4(range->lower, v, range->lower_flags, flags);
+		if (res > 0 || (res == 0 && (range->range_flags & VERSIONRANGE_LOWER_EXCLUSIVE)))
+			return 0;
+	}
+	if (range->upper != NULL) {
+		res = version_compare4(v, range->upper, flags, range->upper_flags);
+		if (res > 0 || (res == 0 && (range->range_flags & VERSIONRANGE_UPPER_EXCLUSIVE)))
+			return 0;
+	}
+	return 1;
+}
+
+static int check_queries(const version_range_t* ranges, size_t num_ranges, const char* title) {
+	version_range_index_t* index;
+	query_result_t result;
+	size_t iversion, iflags, irange, expected, returned;
+	int errors = 0;
+
+	fprintf(stderr, "\nTest group: %s (%d ranges)\n", title, (int)num_ranges);
+
+	if ((index = version_range_index_build(ranges, num_ranges)) == NULL) {
+		fprintf(stderr, "[FAIL] cannot build index\n");
+		return 1;
+	}
+
+	result.matched = calloc(num_ranges + 1, 1);
+
+	for (iversion = 0; iversion < COUNT(versions); iversion++) {
+		for (iflags = 0; iflags < COUNT(endpoint_flags); iflags++) {
+			const char* v = versions[iversion];
+			int flags = endpoint_flags[iflags];
+
+			memset(result.matched, 0, num_ranges);
+			result.count = 0;
+
+			returned = version_range_index_query(index, v, flags, collect, &result);
+
+			expected = 0;
+			for (irange = 0; irange < num_ranges; irange++) {
+				int contains = range_contains(&ranges[irange], v, flags);
+				expected += contains;
+				if (result.matched[irange] != contains) {
+					fprintf(stderr, "[FAIL] \"%s\" (0x%x) range %d: expected %s\n", v, flags, (int)irange, contains ? "match" : "no match");
+					errors++;
+				}
+			}
+
+			if (returned != expected || result.count != expected) {
+				fprintf(stderr, "[FAIL] \"%s\" (0x%x): expected %d matches, got %d\n", v, flags, (int)expected, (int)returned);
+				errors++;
+			} else {
+				fprintf(stderr, "[ OK ] \"%s\" (0x%x): %d matches\n", v, flags, (int)expected);
+			}
+		}
+	}
+
+	free(result.matched);
+	version_range_index_free(index);
+
+	return errors;
+}
+
+static int stop_immediately(size_t range, void* userdata) {
+	(void)range;
+	(void)userdata;
+	return 1;
+}
+
+static int count_test(const version_range_index_t* index, const char* v, size_t expected) {
+	size_t returned = version_range_index_query(index, v, 0, NULL, NULL);
+
+	if (returned == expected) {
+		fprintf(stderr, "[ OK ] \"%s\": %d matches\n", v, (int)returned);
+		return 0;
+	} else {
+		fprintf(stderr, "[FAIL] \"%s\": expected %d matches, got %d\n", v, (int)expected, (int)returned);
+		return 1;
+	}
+}
+
+static clock_t time_queries(const version_range_index_t* index, const char* v) {
+	clock_t start = clock();
+	size_t i;
+
+	for (i = 0; i < SHARED_ENDPOINT_QUERIES; i++)
+		version_range_index_query(index, v, 0, NULL, NULL);
+
+	return clock() - start;
+}
+
+/* common >X, <Y ranges queried at exactly X must not visit them all */
+static int shared_endpoint_test(void) {
+	version_range_t* ranges;
+	version_range_index_t* index;
+	clock_t at_endpoint, below;
+	size_t i;
+	int errors = 0;
+
+	fprintf(stderr, "\nTest group: shared exclusive lower endpoint (%d ranges)\n", SHARED_ENDPOINT_RANGES);
+
+	ranges = calloc(SHARED_ENDPOINT_RANGES, sizeof(version_range_t));
+	for (i = 0; i < SHARED_ENDPOINT_RANGES; i++) {
+		ranges[i].lower = "1.0";
+		ranges[i].upper = "2.0";
+		ranges[i].range_flags = VERSIONRANGE_LOWER_EXCLUSIVE | (i % 2 ? VERSIONRANGE_UPPER_EXCLUSIVE : 0);
+	}
+
+	if ((index = version_range_index_build(ranges, SHARED_ENDPOINT_RANGES)) == NULL) {
+		fprintf(stderr, "[FAIL] cannot build index\n");
+		free(ranges);
+		return 1;
+	}
+
+	errors += count_test(index, "0.5", 0);
+	errors += count_test(index, "1.0", 0);
+	errors += count_test(index, "1.5", SHARED_ENDPOINT_RANGES);
+	errors += count_test(index, "2.0", SHARED_ENDPOINT_RANGES / 2);
+	errors += count_test(index, "2.5", 0);
+
+	/* both are empty queries, which should take the same time; generous
+	 * margin, as walking all ranges is thousands times slower */
+	below = time_queries(index, "0.5");
+	at_endpoint = time_queries(index, "1.0");
+	if (at_endpoint <= below * 10 + CLOCKS_PER_SEC / 100) {
+		fprintf(stderr, "[ OK ] query at shared endpoint is as fast as below it\n");
+	} else {
+		fprintf(stderr, "[FAIL] query at shared endpoint is too slow: %ld vs %ld clock ticks\n", (long)at_endpoint, (long)below);
+		errors++;
+	}
+
+	version_range_index_free(index);
+	free(ranges);
+
+	return errors;
+}
+
+int main(void) {
+	version_range_t* ranges;
+	size_t num_ranges = 0, ilower, iupper, ilf, iuf, iexcl;
+	version_range_index_t* index;
+	int errors = 0;
+
+	ranges = calloc(COUNT(versions) * COUNT(versions) * COUNT(endpoint_flags) * COUNT(endpoint_flags) * 4 + 8, sizeof(version_range_t));
+
+	errors += check_queries(ranges, 0, "empty index");
+
+	ranges[0].lower = "1.0";
+	ranges[0].upper = "1.0";
+	ranges[0].lower_flags = VERSIONFLAG_LOWER_BOUND;
+	ranges[0].upper_flags = VERSIONFLAG_UPPER_BOUND;
+	errors += check_queries(ranges, 1, "single release");
+
+	ranges[1].lower = "1.0";
+	ranges[2].upper = "1.0";
+	ranges[2].range_flags = VERSIONRANGE_UPPER_EXCLUSIVE;
+	ranges[3].lower = "1.0";
+	ranges[3].upper = "1.1";
+	ranges[3].range_flags = VERSIONRANGE_LOWER_EXCLUSIVE;
+	errors += check_queries(ranges, 5, "unbounded ranges");
+
+	for (ilower = 0; ilower < COUNT(versions); ilower += 2) {
+		for (iupper = 1; iupper < COUNT(versions); iupper += 2) {
+			for (ilf = 0; ilf < COUNT(endpoint_flags); ilf++) {
+				for (iuf = 0; iuf < COUNT(endpoint_flags); iuf++) {
+					for (iexcl = 0; iexcl < 4; iexcl++) {
+						ranges[num_ranges].lower = versions[ilower];
+						ranges[num_ranges].upper = versions[iupper];
+						ranges[num_ranges].lower_flags = endpoint_flags[ilf];
+						ranges[num_ranges].upper_flags = endpoint_flags[iuf];
+						ranges[num_ranges].range_flags = (int)iexcl;
+						num_ranges++;
+					}
+				}
+			}
+		}
+	}
+	errors += check_queries(ranges, num_ranges, "all endpoint combinations");
+
+	fprintf(stderr, "\nTest group: early stop\n");
+	index = version_range_index_build(ranges, num_ranges);
+	if (version_range_index_query(index, "1.0", 0, stop_immediately, NULL) == 1) {
+		fprintf(stderr, "[ OK ] query stopped after first match\n");
+	} else {
+		fprintf(stderr, "[FAIL] query did not stop after first match\n");
+		errors++;
+	}
+	version_range_index_free(index);
+
+	free(ranges);
+
+	errors += shared_endpoint_test();
+
+	return errors != 0;
+}
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#define LIBVERSION_NO_DEPRECATED /* disable deprecated APIs */
+
+#include <libversion/set.h>
+#include <libversion/set_file.h>
+#include <libversion/version.h>
+
+#include <stdio.h>
+#include <string.h>
+
+/* Checks that index file gives the same answers as in-memory set it was written from */
+
+static const char* versions[] = {
+	"1.0", "0.9", "1.0alpha1", "1.0.1", "1.0a", "1.0.0", "2.0", "1.0rc1",
+	"1.0patch1", "0.99", "1.1", "1.0beta2", "10.0", "1.0p1", "1.0.0.0.1",
+	"123456789012345678901234567890", "1.0", "",
+};
+
+static const char* probes[] = {
+	"", "0", "0.9", "1.0", "1.0.0.0", "1.0pre1", "1.0.0.1", "1.0b", "1.0.2", "2", "3", "a", "1.0p1",
+	"123456789012345678901234567890",
+};
+
+static const int probe_flags[] = {
+	0, VERSIONFLAG_P_IS_PATCH, VERSIONFLAG_LOWER_BOUND, VERSIONFLAG_UPPER_BOUND,
+};
+
+static const char* path = "set_file_test.idx";
+
+#define COUNT(a) (sizeof(a)/sizeof(a[0]))
+
+static int check(const char* what, const char* v, int flags, size_t expected, size_t result) {
+	if (expected == result) {
+		fprintf(stderr, "[ OK ] %s(\"%s\", 0x%x) = %d\n", what, v, flags, (int)result);
+		return 0;
+	} else {
+		fprintf(stderr, "[FAIL] %s(\"%s\", 0x%x): expected %d, got %d\n", what, v, flags, (int)expected, (int)result);
+		return 1;
+	}
+}
+
+static int check_file(const version_set_t* set) {
+	version_set_file_t* file;
+	version_range_t range;
+	size_t i, ip, iflags;
+	int errors = 0;
+
+	if (!version_set_write(set, path) || (file = version_set_file_open(path)) == NULL) {
+		fprintf(stderr, "[FAIL] cannot write and open index file\n");
+		return 1;
+	}
+
+	errors += check("size", "", 0, version_set_size(set), version_set_file_size(file));
+
+	for (i = 0; i <= version_set_size(set); i++) {
+		const char* expected = version_set_get(set, i);
+		const char* result = version_set_file_get(file, i);
+		if ((expected == NULL) != (result == NULL) || (expected != NULL && strcmp(expected, result) != 0)) {
+			fprintf(stderr, "[FAIL] get(%d): expected \"%s\", got \"%s\"\n", (int)i, expected ? expected : "(null)", result ? result : "(null)");
+			errors++;
+		}
+	}
+
+	for (ip = 0; ip < COUNT(probes); ip++) {
+		for (iflags = 0; iflags < COUNT(probe_flags); iflags++) {
+			const char* v = probes[ip];
+			int flags = probe_flags[iflags];
+
+			errors += check("lower_bound", v, flags, version_set_lower_bound(set, v, flags), version_set_file_lower_bound(file, v, flags));
+			errors += check("upper_bound", v, flags, version_set_upper_bound(set, v, flags), version_set_file_upper_bound(file, v, flags));
+
+			memset(&range, 0, sizeof(range));
+			range.lower = "1.0";
+			range.upper = v;
+			range.upper_flags = flags;
+			range.range_flags = VERSIONRANGE_UPPER_EXCLUSIVE;
+			errors += check("count_range", v, flags, version_set_count_range(set, &range), version_set_file_count_range(file, &range));
+		}
+	}
+
+	version_set_file_close(file);
+
+	return errors;
+}
+
+static int check_corrupt(size_t truncate_at, size_t corrupt_at) {
+	char buffer[4096];
+	size_t size;
+	FILE* file;
+	version_set_file_t* set_file;
+
+	file = fopen(path, "rb");
+	size = fread(buffer, 1, sizeof(buffer), file);
+	fclose(file);
+
+	if (truncate_at < size)
+		size = truncate_at;
+	if (corrupt_at < size)
+		buffer[corrupt_at] ^= 0x55;
+
+	file = fopen(path, "wb");
+	fwrite(buffer, 1, size, file);
+	fclose(file);
+
+	if ((set_file = version_set_file_open(path)) != NULL) {
+		fprintf(stderr, "[FAIL] corrupt file (truncated at %d, corrupted at %d) was accepted\n", (int)truncate_at, (int)corrupt_at);
+		version_set_file_close(set_file);
+		return 1;
+	}
+
+	fprintf(stderr, "[ OK ] corrupt file (truncated at %d, corrupted at %d) was rejected\n", (int)truncate_at, (int)corrupt_at);
+	return 0;
+}
+
+/* files already open must not see the file being replaced */
+static int check_rewrite(const version_set_t* set) {
+	const char* replacement[] = { "3.0" };
+	version_set_t* other = version_set_build(replacement, COUNT(replacement), 0);
+	version_set_file_t* old_file;
+	version_set_file_t* new_file;
+	int errors = 0;
+
+	if (!version_set_write(set, path) || (old_file = version_set_file_open(path)) == NULL) {
+		fprintf(stderr, "[FAIL] cannot write and open index file\n");
+		version_set_free(other);
+		return 1;
+	}
+
+	errors += check("rewrite", "", 0, 1, (size_t)version_set_write(other, path));
+	errors += check("old file size", "", 0, version_set_size(set), version_set_file_size(old_file));
+	errors += check("old file get", "", 0, 0, (size_t)strcmp(version_set_get(set, 0), version_set_file_get(old_file, 0)));
+	errors += check("old file lower_bound", "1.0", 0, version_set_lower_bound(set, "1.0", 0), version_set_file_lower_bound(old_file, "1.0", 0));
+
+	if ((new_file = version_set_file_open(path)) != NULL) {
+		errors += check("new file size", "", 0, 1, version_set_file_size(new_file));
+		version_set_file_close(new_file);
+	} else {
+		fprintf(stderr, "[FAIL] cannot open rewritten index file\n");
+		errors++;
+	}
+
+	version_set_file_close(old_file);
+	version_set_free(other);
+
+	errors += check("write into missing directory", "", 0, 0, (size_t)version_set_write(set, "nonexistent/set_file_test.idx"));
+
+	return errors;
+}
+
+int main(void) {
+	version_set_t* set;
+	version_set_file_t* file;
+	int errors = 0;
+
+	fprintf(stderr, "Test group: empty set\n");
+	set = version_set_build(NULL, 0, 0);
+	errors += check_file(set);
+	version_set_free(set);
+
+	fprintf(stderr, "\nTest group: versions\n");
+	set = version_set_build(versions, COUNT(versions), VERSIONFLAG_P_IS_PATCH);
+	errors += check_file(set);
+
+	file = version_set_file_open(path);
+	errors += check("flags", "", 0, VERSIONFLAG_P_IS_PATCH, (size_t)version_set_file_flags(file));
+	version_set_file_close(file);
+
+	fprintf(stderr, "\nTest group: rewriting\n");
+	errors += check_rewrite(set);
+
+	fprintf(stderr, "\nTest group: corrupt files\n");
+	errors += check("missing file", "", 0, 1, version_set_file_open("nonexistent.idx") == NULL);
+	errors += check_corrupt(0, (size_t)-1);
+	errors += check_corrupt(16, (size_t)-1);
+	errors += check_file(set) != 0;
+	errors += check_corrupt((size_t)-1, 0);
+	errors += check_file(set) != 0;
+	errors += check_corrupt((size_t)-1, 8);
+	errors += check_file(set) != 0;
+	errors += check_corrupt(200, (size_t)-1);
+	version_set_free(set);
+
+	remove(path);
+
+	return errors != 0;
+}
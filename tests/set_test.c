@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#define LIBVERSION_NO_DEPRECATED /* disable deprecated APIs */
+
+#include <libversion/set.h>
+#include <libversion/version.h>
+
+#include <stdio.h>
+#include <string.h>
+
+static const char* versions[] = {
+	"1.0", "0.9", "1.0alpha1", "1.0.1", "1.0a", "1.0.0", "2.0", "1.0rc1",
+	"1.0patch1", "0.99", "1.1", "1.0beta2", "10.0", "1.0p1", "1.0.0.0.1",
+};
+
+static const char* probes[] = {
+	"", "0", "0.9", "1.0", "1.0.0.0", "1.0pre1", "1.0.0.1", "1.0b", "1.0.2", "2", "3", "a", "1.0p1",
+};
+
+static const int probe_flags[] = {
+	0, VERSIONFLAG_P_IS_PATCH, VERSIONFLAG_LOWER_BOUND, VERSIONFLAG_UPPER_BOUND,
+};
+
+#define COUNT(a) (sizeof(a)/sizeof(a[0]))
+
+static int check(const char* what, const char* v, int flags, size_t expected, size_t result) {
+	if (expected == result) {
+		fprintf(stderr, "[ OK ] %s(\"%s\", 0x%x) = %d\n", what, v, flags, (int)result);
+		return 0;
+	} else {
+		fprintf(stderr, "[FAIL] %s(\"%s\", 0x%x): expected %d, got %d\n", what, v, flags, (int)expected, (int)result);
+		return 1;
+	}
+}
+
+int main(void) {
+	version_set_t* set;
+	version_range_t range;
+	size_t i, ip, iflags, less, not_greater;
+	int errors = 0;
+
+	fprintf(stderr, "Test group: empty set\n");
+	set = version_set_build(NULL, 0, 0);
+	errors += check("lower_bound", "1.0", 0, 0, version_set_lower_bound(set, "1.0", 0));
+	errors += check("predecessor", "1.0", 0, VERSIONSET_NONE, version_set_predecessor(set, "1.0", 0));
+	errors += check("successor", "1.0", 0, VERSIONSET_NONE, version_set_successor(set, "1.0", 0));
+	errors += check("rank", "1.0", 0, 0, version_set_rank(set, "1.0", 0));
+	version_set_free(set);
+
+	set = version_set_build(versions, COUNT(versions), VERSIONFLAG_P_IS_PATCH);
+
+	fprintf(stderr, "\nTest group: ordering\n");
+	errors += check("size", "", 0, COUNT(versions), version_set_size(set));
+	for (i = 1; i < version_set_size(set); i++) {
+		const char* a = version_set_get(set, i - 1);
+		const char* b = version_set_get(set, i);
+		int res = version_compare4(a, b, VERSIONFLAG_P_IS_PATCH, VERSIONFLAG_P_IS_PATCH);
+		if (res > 0 || (res == 0 && strcmp(a, b) > 0)) {
+			fprintf(stderr, "[FAIL] \"%s\" is placed before \"%s\"\n", a, b);
+			errors++;
+		} else {
+			fprintf(stderr, "[ OK ] \"%s\" is placed before \"%s\"\n", a, b);
+		}
+	}
+	errors += check("get", "", 0, 1, version_set_get(set, COUNT(versions)) == NULL);
+
+	fprintf(stderr, "\nTest group: queries\n");
+	for (ip = 0; ip < COUNT(probes); ip++) {
+		for (iflags = 0; iflags < COUNT(probe_flags); iflags++) {
+			const char* v = probes[ip];
+			int flags = probe_flags[iflags];
+
+			less = not_greater = 0;
+			for (i = 0; i < COUNT(versions); i++) {
+				int res = version_compare4(versions[i], v, VERSIONFLAG_P_IS_PATCH, flags);
+				less += res < 0;
+				not_greater += res <= 0;
+			}
+
+			errors += check("lower_bound", v, flags, less, version_set_lower_bound(set, v, flags));
+			errors += check("upper_bound", v, flags, not_greater, version_set_upper_bound(set, v, flags));
+			errors += check("predecessor", v, flags, less == 0 ? VERSIONSET_NONE : less - 1, version_set_predecessor(set, v, flags));
+			errors += check("successor", v, flags, not_greater == COUNT(versions) ? VERSIONSET_NONE : not_greater, version_set_successor(set, v, flags));
+			errors += check("rank", v, flags, COUNT(versions) - not_greater, version_set_rank(set, v, flags));
+		}
+	}
+
+	fprintf(stderr, "\nTest group: range count\n");
+	memset(&range, 0, sizeof(range));
+	errors += check("count_range", "(unbounded)", 0, COUNT(versions), version_set_count_range(set, &range));
+
+	range.lower = range.upper = "1.0";
+	range.lower_flags = VERSIONFLAG_LOWER_BOUND;
+	range.upper_flags = VERSIONFLAG_UPPER_BOUND;
+	errors += check("count_range", "1.0 release", 0, 10, version_set_count_range(set, &range));
+
+	range.lower_flags = range.upper_flags = 0;
+	errors += check("count_range", "[1.0, 1.0]", 0, 2, version_set_count_range(set, &range));
+
+	range.range_flags = VERSIONRANGE_LOWER_EXCLUSIVE;
+	errors += check("count_range", "(1.0, 1.0]", 0, 0, version_set_count_range(set, &range));
+
+	range.lower = "1.0";
+	range.upper = "2.0";
+	range.range_flags = VERSIONRANGE_LOWER_EXCLUSIVE | VERSIONRANGE_UPPER_EXCLUSIVE;
+	errors += check("count_range", "(1.0, 2.0)", 0, 6, version_set_count_range(set, &range));
+
+	version_set_free(set);
+
+	return errors != 0;
+}
@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#define LIBVERSION_NO_DEPRECATED /* disable deprecated APIs */
+
+#include <libversion/version.h>
+
+#include <sqlite3.h>
+
+#include <stdio.h>
+#include <string.h>
+
+/* Loads the extension into in-process SQLite and checks that collation,
+ * functions and aggregates agree with version_compare4() */
+
+static const char* versions[] = {
+	"1.0", "0.9", "1.0alpha1", "1.0.1", "1.0a", "1.0.0", "2.0", "1.0rc1",
+	"1.0patch1", "0.99", "1.1", "1.0beta2", "10.0", "1.0p1", "1.0.0.0.1",
+	"123456789012345678901234567890", "",
+};
+
+#define COUNT(a) (sizeof(a)/sizeof(a[0]))
+
+/* runs the query and returns all values of all rows separated with spaces */
+static const char* query(sqlite3* db, const char* sql) {
+	static char result[1024];
+	sqlite3_stmt* stmt;
+	size_t length = 0;
+	int i;
+
+	result[0] = '\0';
+
+	if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) != SQLITE_OK)
+		return "ERROR";
+
+	while (sqlite3_step(stmt) == SQLITE_ROW) {
+		for (i = 0; i < sqlite3_column_count(stmt); i++) {
+			const char* value = sqlite3_column_type(stmt, i) == SQLITE_NULL ? "NULL" : (const char*)sqlite3_column_text(stmt, i);
+			length += snprintf(result + length, sizeof(result) - length, "%s%s", length ? " " : "", value);
+		}
+	}
+
+	if (sqlite3_finalize(stmt) != SQLITE_OK)
+		return "ERROR";
+
+	return result;
+}
+
+static int check(sqlite3* db, const char* sql, const char* expected) {
+	const char* result = query(db, sql);
+
+	if (strcmp(result, expected) == 0) {
+		fprintf(stderr, "[ OK ] %s = %s\n", sql, result);
+		return 0;
+	} else {
+		fprintf(stderr, "[FAIL] %s: expected \"%s\", got \"%s\"\n", sql, expected, result);
+		return 1;
+	}
+}
+
+static int check_contains(sqlite3* db, const char* sql, const char* expected, int should_contain) {
+	const char* result = query(db, sql);
+
+	if ((strstr(result, expected) != NULL) == should_contain) {
+		fprintf(stderr, "[ OK ] %s %s \"%s\"\n", sql, should_contain ? "contains" : "does not contain", expected);
+		return 0;
+	} else {
+		fprintf(stderr, "[FAIL] %s: got \"%s\"\n", sql, result);
+		return 1;
+	}
+}
+
+static int check_key(sqlite3* db, const char* v, int flags) {
+	unsigned char expected[128];
+	size_t expected_length = version_sort_key(v, flags, expected, sizeof(expected));
+	sqlite3_stmt* stmt;
+	int ok;
+
+	if (sqlite3_prepare_v2(db, "SELECT version_key(?, ?)", -1, &stmt, NULL) != SQLITE_OK) {
+		fprintf(stderr, "[FAIL] cannot prepare key query\n");
+		return 1;
+	}
+
+	sqlite3_bind_text(stmt, 1, v, -1, SQLITE_STATIC);
+	sqlite3_bind_int(stmt, 2, flags);
+
+	ok = sqlite3_step(stmt) == SQLITE_ROW &&
+		sqlite3_column_type(stmt, 0) == SQLITE_BLOB &&
+		(size_t)sqlite3_column_bytes(stmt, 0) == expected_length &&
+		memcmp(sqlite3_column_blob(stmt, 0), expected, expected_length) == 0;
+
+	sqlite3_finalize(stmt);
+
+	if (ok)
+		return 0;
+
+	fprintf(stderr, "[FAIL] version_key(\"%s\", %d) differs from version_sort_key()\n", v, flags);
+	return 1;
+}
+
+static int check_order(sqlite3* db, const char* sql) {
+	sqlite3_stmt* stmt;
+	char previous[128] = "";
+	int errors = 0, rows = 0;
+
+	if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) != SQLITE_OK) {
+		fprintf(stderr, "[FAIL] cannot prepare %s\n", sql);
+		return 1;
+	}
+
+	while (sqlite3_step(stmt) == SQLITE_ROW) {
+		const char* v = (const char*)sqlite3_column_text(stmt, 0);
+		if (rows++ > 0 && version_compare2(previous, v) > 0) {
+			fprintf(stderr, "[FAIL] %s: \"%s\" is placed before \"%s\"\n", sql, previous, v);
+			errors++;
+		}
+		snprintf(previous, sizeof(previous), "%s", v);
+	}
+
+	sqlite3_finalize(stmt);
+
+	if (rows != (int)COUNT(versions)) {
+		fprintf(stderr, "[FAIL] %s: got %d rows\n", sql, rows);
+		errors++;
+	}
+
+	if (!errors)
+		fprintf(stderr, "[ OK ] %s\n", sql);
+
+	return errors;
+}
+
+int main(int argc, char** argv) {
+	sqlite3* db;
+	char* error = NULL;
+	char sql[256];
+	size_t i, count;
+	int errors = 0;
+
+	if (argc != 2) {
+		fprintf(stderr, "Usage: %s path-to-extension\n", argv[0]);
+		return 1;
+	}
+
+	fprintf(stderr, "Test group: loading\n");
+	if (sqlite3_open(":memory:", &db) != SQLITE_OK) {
+		fprintf(stderr, "[FAIL] cannot open database\n");
+		return 1;
+	}
+	sqlite3_enable_load_extension(db, 1);
+	if (sqlite3_load_extension(db, argv[1], NULL, &error) != SQLITE_OK) {
+		fprintf(stderr, "[FAIL] cannot load extension: %s\n", error ? error : "unknown error");
+		sqlite3_free(error);
+		sqlite3_close(db);
+		return 1;
+	}
+	fprintf(stderr, "[ OK ] extension loaded\n");
+
+	errors += check(db, "CREATE TABLE packages(name TEXT, version TEXT)", "");
+	for (i = 0; i < COUNT(versions); i++) {
+		snprintf(sql, sizeof(sql), "INSERT INTO packages VALUES('%s', '%s')", i % 2 ? "foo" : "bar", versions[i]);
+		errors += check(db, sql, "");
+	}
+	errors += check(db, "INSERT INTO packages VALUES('baz', NULL)", "");
+
+	fprintf(stderr, "\nTest group: comparison\n");
+	errors += check(db, "SELECT version_compare('0.99', '1.0')", "-1");
+	errors += check(db, "SELECT version_compare('1.0', '1.0.0')", "0");
+	errors += check(db, "SELECT version_compare('1.0', '1.0rc1')", "1");
+	errors += check(db, "SELECT version_compare('1.0p1', '1.0post1', 1, 0)", "0");
+	errors += check(db, "SELECT version_compare('1.0alpha1', '1.0', 0, 4)", "1");
+	errors += check(db, "SELECT version_compare('1.0alpha1', '1.0', 0, 8)", "-1");
+	errors += check(db, "SELECT version_compare(NULL, '1.0')", "NULL");
+	errors += check(db, "SELECT version_compare('1.0', '1.0', 'p', 0)", "ERROR");
+
+	fprintf(stderr, "\nTest group: collation\n");
+	errors += check(db, "SELECT '1.0' = '1.0.0' COLLATE VERSION", "1");
+	errors += check(db, "SELECT '1.0alpha1' < '1.0' COLLATE VERSION", "1");
+	errors += check_order(db, "SELECT version FROM packages WHERE version IS NOT NULL ORDER BY version COLLATE VERSION");
+	errors += check(db, "SELECT max(version COLLATE VERSION) FROM packages", versions[15]);
+	errors += check(db, "CREATE INDEX packages_collated ON packages(version COLLATE VERSION)", "");
+	errors += check_contains(db, "EXPLAIN QUERY PLAN SELECT version FROM packages ORDER BY version COLLATE VERSION", "packages_collated", 1);
+	errors += check_contains(db, "EXPLAIN QUERY PLAN SELECT version FROM packages ORDER BY version COLLATE VERSION", "TEMP B-TREE", 0);
+
+	fprintf(stderr, "\nTest group: keys\n");
+	for (i = 0; i < COUNT(versions); i++) {
+		errors += check_key(db, versions[i], 0);
+		errors += check_key(db, versions[i], VERSIONFLAG_P_IS_PATCH | VERSIONFLAG_LOWER_BOUND);
+		errors += check_key(db, versions[i], VERSIONFLAG_UPPER_BOUND);
+	}
+	fprintf(stderr, "[%s] version_key agrees with version_sort_key\n", errors ? "FAIL" : " OK ");
+	errors += check(db, "SELECT version_key(NULL) IS NULL", "1");
+	errors += check_order(db, "SELECT version FROM packages WHERE version IS NOT NULL ORDER BY version_key(version)");
+	errors += check(db, "CREATE INDEX packages_key ON packages(version_key(version))", "");
+
+	for (count = 0, i = 0; i < COUNT(versions); i++)
+		count += version_compare4(versions[i], "1.0", 0, VERSIONFLAG_LOWER_BOUND) > 0 && version_compare4(versions[i], "1.0", 0, VERSIONFLAG_UPPER_BOUND) < 0;
+	snprintf(sql, sizeof(sql), "%d", (int)count);
+	errors += check(db, "SELECT count(*) FROM packages WHERE version_key(version) BETWEEN version_key('1.0', 4) AND version_key('1.0', 8)", sql);
+	errors += check_contains(db, "EXPLAIN QUERY PLAN SELECT count(*) FROM packages WHERE version_key(version) BETWEEN version_key('1.0', 4) AND version_key('1.0', 8)", "packages_key", 1);
+
+	fprintf(stderr, "\nTest group: aggregates\n");
+	errors += check(db, "SELECT version_max(version) FROM packages", versions[15]);
+	errors += check(db, "SELECT version_min(version) FROM packages", "");
+	errors += check(db, "SELECT name, version_max(version), version_min(version) FROM packages GROUP BY name ORDER BY name", "bar 10.0  baz NULL NULL foo 123456789012345678901234567890 0.9");
+	errors += check(db, "SELECT version_max(version) FROM packages WHERE version IN ('1.0', '1.0p1')", "1.0");
+	errors += check(db, "SELECT version_max(version, 1) FROM packages WHERE version IN ('1.0', '1.0p1')", "1.0p1");
+	errors += check(db, "SELECT version_max(version) FROM packages WHERE 0", "NULL");
+
+	sqlite3_close(db);
+
+	return errors != 0;
+}
@@ -0,0 +1,99 @@
+// Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <libversion/static_version.hpp>
+#include <libversion/version.h>
+
+#include <cstdio>
+#include <string_view>
+
+using libversion::make_static_version;
+using libversion::static_version;
+
+// compile time checks
+static_assert(make_static_version("1.0") == make_static_version("1.0.0"));
+static_assert(make_static_version("1.0alpha1") < make_static_version("1.0"));
+static_assert(make_static_version("1.0") < make_static_version("1.0a"));
+static_assert(make_static_version("1.0a") < make_static_version("1.1"));
+static_assert(make_static_version("1.0patch1") > make_static_version("1.0"));
+static_assert(make_static_version("1.0p1") < make_static_version("1.0"));
+static_assert(make_static_version("1.0p1", VERSIONFLAG_P_IS_PATCH) > make_static_version("1.0"));
+static_assert(make_static_version("1.0foo1", VERSIONFLAG_ANY_IS_PATCH) > make_static_version("1.0"));
+static_assert(make_static_version("1.0", VERSIONFLAG_LOWER_BOUND) < make_static_version("1.0alpha1"));
+static_assert(make_static_version("1.0", VERSIONFLAG_UPPER_BOUND) > make_static_version("1.0.999"));
+static_assert(make_static_version("1.0", VERSIONFLAG_UPPER_BOUND) < make_static_version("1.1alpha1"));
+static_assert(make_static_version("0001.0010") == make_static_version("1.10"));
+static_assert(make_static_version("1.2.3").size() == 3);
+static_assert(make_static_version("1.2a").size() == 3);
+static_assert(libversion::compare("1.0", "1.0.0") == 0);
+static_assert(libversion::compare("1.0", 0, make_static_version("1.1")) < 0);
+
+// Every comparison done by compare_test.c is checked against the
+// constexpr implementation: both fully parsed and with runtime side
+// tokenized on the fly
+static int disagreements = 0;
+static int checks = 0;
+
+static int sign(int v) {
+	return (v > 0) - (v < 0);
+}
+
+static int checked_compare4(const char* v1, const char* v2, int v1_flags, int v2_flags) {
+	const int expected = version_compare4(v1, v2, v1_flags, v2_flags);
+
+	const static_version<256> sv1(v1, v1_flags);
+	const static_version<256> sv2(v2, v2_flags);
+
+	const int results[] = {
+		libversion::compare(sv1, sv2),
+		libversion::compare(v1, v1_flags, sv2),
+		libversion::compare(sv1, v2, v2_flags),
+		libversion::compare(v1, v2, v1_flags, v2_flags),
+	};
+
+	for (int result : results) {
+		if (sign(result) != sign(expected)) {
+			std::fprintf(stderr, "[FAIL] \"%s\" (0x%x) vs \"%s\" (0x%x): C gives %d, constexpr gives %d\n", v1, v1_flags, v2, v2_flags, expected, result);
+			++disagreements;
+		}
+		++checks;
+	}
+
+	return expected;
+}
+
+static int checked_compare2(const char* v1, const char* v2) {
+	return checked_compare4(v1, v2, 0, 0);
+}
+
+#define version_compare2 checked_compare2
+#define version_compare4 checked_compare4
+#define main compare_test_main
+#include "compare_test.c"
+#undef main
+
+int main() {
+	const int errors = compare_test_main();
+
+	std::fprintf(stderr, "\nTest group: constexpr agreement\n");
+	std::fprintf(stderr, "[%s] %d comparisons\n", disagreements ? "FAIL" : " OK ", checks);
+
+	return errors != 0 || disagreements != 0;
+}
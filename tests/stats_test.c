@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#define LIBVERSION_NO_DEPRECATED /* disable deprecated APIs */
+
+#include <libversion/stats.h>
+#include <libversion/version.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+#define THREAD_COMPARISONS 1000
+
+static int check(const char* what, uint64_t expected, uint64_t result) {
+	if (expected == result) {
+		fprintf(stderr, "[ OK ] %s = %lu\n", what, (unsigned long)result);
+		return 0;
+	} else {
+		fprintf(stderr, "[FAIL] %s: expected %lu, got %lu\n", what, (unsigned long)expected, (unsigned long)result);
+		return 1;
+	}
+}
+
+#ifndef _WIN32
+static void* thread_main(void* arg) {
+	size_t i;
+	(void)arg;
+	for (i = 0; i < THREAD_COMPARISONS; i++)
+		version_compare2("1.0", "1.0.1");
+	return NULL;
+}
+#endif
+
+int main(void) {
+	version_stats_t stats;
+	int errors = 0;
+
+	if (!version_stats_snapshot(&stats)) {
+		fprintf(stderr, "Test group: disabled statistics\n");
+		errors += check("compare_calls", 0, stats.compare_calls);
+		version_compare2("1.0", "1.0.1");
+		version_stats_snapshot(&stats);
+		errors += check("compare_calls", 0, stats.compare_calls);
+		return errors != 0;
+	}
+
+	fprintf(stderr, "Test group: single comparison\n");
+	version_stats_reset();
+	version_compare2("1.0", "1.0.1");
+	version_stats_snapshot(&stats);
+	errors += check("compare_calls", 1, stats.compare_calls);
+	errors += check("components_parsed", 5, stats.components_parsed);
+	errors += check("padding_components", 1, stats.padding_components);
+	errors += check("decided_at[2]", 1, stats.decided_at[2]);
+	errors += check("equal_results", 0, stats.equal_results);
+
+	fprintf(stderr, "\nTest group: keywords\n");
+	version_stats_reset();
+	version_compare4("1.0alpha1", "1.0p1", 0, VERSIONFLAG_P_IS_PATCH);
+	version_compare2("1.0a", "1.0a");
+	version_stats_snapshot(&stats);
+	errors += check("compare_calls", 2, stats.compare_calls);
+	errors += check("equal_results", 1, stats.equal_results);
+	errors += check("decided_at[2]", 1, stats.decided_at[2]);
+	errors += check("keywords_pre_release", 1, stats.keywords_pre_release);
+	errors += check("keywords_post_release", 1, stats.keywords_post_release);
+	errors += check("keywords_unknown", 2, stats.keywords_unknown);
+	errors += check("letter_suffix_lookaheads", 4, stats.letter_suffix_lookaheads);
+
+	fprintf(stderr, "\nTest group: sort keys\n");
+	{
+		unsigned char key[64];
+
+		version_stats_reset();
+		version_sort_key("1.0alpha1", 0, key, sizeof(key));
+		version_abbreviated_key("1.0", 0);
+		version_stats_snapshot(&stats);
+		errors += check("key_calls", 1, stats.key_calls);
+		errors += check("abbreviated_key_calls", 1, stats.abbreviated_key_calls);
+		errors += check("keywords_pre_release", 1, stats.keywords_pre_release);
+		errors += check("compare_calls", 0, stats.compare_calls);
+	}
+
+	fprintf(stderr, "\nTest group: deep decisions\n");
+	version_stats_reset();
+	version_compare2("1.2.3.4.5.6.7.8.9.10.11.12.13.14.15.16.17.18", "1.2.3.4.5.6.7.8.9.10.11.12.13.14.15.16.17.19");
+	version_stats_snapshot(&stats);
+	errors += check("decided_at[15+]", 1, stats.decided_at[VERSION_STATS_DECISION_DEPTH - 1]);
+
+#ifndef _WIN32
+	fprintf(stderr, "\nTest group: threads\n");
+	{
+		pthread_t threads[4];
+		size_t i;
+
+		version_stats_reset();
+		for (i = 0; i < 4; i++)
+			pthread_create(&threads[i], NULL, thread_main, NULL);
+		for (i = 0; i < 4; i++)
+			pthread_join(threads[i], NULL);
+		version_compare2("1.0", "1.0");
+
+		/* counters of exited threads are kept */
+		version_stats_snapshot(&stats);
+		errors += check("compare_calls", 4 * THREAD_COMPARISONS + 1, stats.compare_calls);
+		errors += check("decided_at[2]", 4 * THREAD_COMPARISONS, stats.decided_at[2]);
+
+		version_stats_reset();
+		version_stats_snapshot(&stats);
+		errors += check("compare_calls after reset", 0, stats.compare_calls);
+	}
+#endif
+
+	return errors != 0;
+}
@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#define LIBVERSION_NO_DEPRECATED /* disable deprecated APIs */
+
+#include <libversion/trie.h>
+#include <libversion/version.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char* versions[] = {
+	"1.0", "0.9", "1.0alpha1", "1.0.1", "1.0a", "1.0.0", "2.0", "1.0rc1",
+	"1.0patch1", "0.99", "1.1", "1.0beta2", "10.0", "1.0p1", "1.0.0.0.1",
+	"1.0.0.0.a", "", "1.0errata2", "123456789012345678901234567890", "1.0.x.5",
+	"20190101", "1.1pre1", "1.1.0a.2",
+};
+
+static const char* releases[] = {
+	NULL, "", "0", "1", "1.0", "1.0.0", "1.0.0.0", "1.0a", "1.1", "1.1.0", "2", "3", "1.0p1",
+};
+
+#define COUNT(a) (sizeof(a)/sizeof(a[0]))
+
+typedef struct {
+	const char* versions[64];
+	size_t values[64];
+	size_t count;
+} collected_t;
+
+static int collect(const char* version, size_t value, void* userdata) {
+	collected_t* collected = (collected_t*)userdata;
+	collected->versions[collected->count] = strdup(version);
+	collected->values[collected->count++] = value;
+	return 0;
+}
+
+static void free_collected(collected_t* collected) {
+	while (collected->count > 0)
+		free((char*)collected->versions[--collected->count]);
+}
+
+static int in_release(const char* v, const char* release, int flags) {
+	return release == NULL || (
+		version_compare4(v, release, flags, flags | VERSIONFLAG_LOWER_BOUND) > 0 &&
+		version_compare4(v, release, flags, flags | VERSIONFLAG_UPPER_BOUND) < 0
+	);
+}
+
+static int check_release(version_trie_t* trie, size_t num_versions, const char* release, int flags) {
+	collected_t collected = { {0}, {0}, 0 };
+	size_t i, expected = 0, newest = (size_t)-1;
+	int errors = 0;
+
+	/* expected are the first occurrences of distinct versions */
+	for (i = 0; i < num_versions; i++) {
+		size_t j;
+		for (j = 0; j < i && version_compare4(versions[i], versions[j], flags, flags) != 0; j++) {
+		}
+		if (j == i && in_release(versions[i], release, flags)) {
+			expected++;
+			if (newest == (size_t)-1 || version_compare4(versions[i], versions[newest], flags, flags) > 0)
+				newest = i;
+		}
+	}
+
+	version_trie_foreach(trie, release, collect, &collected);
+
+	if (collected.count != expected) {
+		fprintf(stderr, "[FAIL] release \"%s\": expected %d versions, got %d\n", release ? release : "(all)", (int)expected, (int)collected.count);
+		errors++;
+	}
+
+	for (i = 0; i < collected.count; i++) {
+		const char* v = collected.versions[i];
+		size_t value = collected.values[i];
+
+		if (value >= num_versions || version_compare4(v, versions[value], flags, flags) != 0 || !in_release(v, release, flags)) {
+			fprintf(stderr, "[FAIL] release \"%s\": unexpected \"%s\" (%d)\n", release ? release : "(all)", v, (int)value);
+			errors++;
+		} else if (i > 0 && version_compare4(collected.versions[i - 1], v, flags, flags) >= 0) {
+			fprintf(stderr, "[FAIL] release \"%s\": \"%s\" goes after \"%s\"\n", release ? release : "(all)", v, collected.versions[i - 1]);
+			errors++;
+		} else {
+			fprintf(stderr, "[ OK ] release \"%s\": \"%s\" (\"%s\")\n", release ? release : "(all)", v, versions[value]);
+		}
+	}
+
+	free_collected(&collected);
+
+	version_trie_newest(trie, release, collect, &collected);
+
+	if (newest == (size_t)-1 ? collected.count != 0 : collected.count != 1 || collected.values[0] != newest) {
+		fprintf(stderr, "[FAIL] release \"%s\": wrong newest version\n", release ? release : "(all)");
+		errors++;
+	} else {
+		fprintf(stderr, "[ OK ] release \"%s\": newest is \"%s\"\n", release ? release : "(all)", newest == (size_t)-1 ? "(none)" : versions[newest]);
+	}
+
+	free_collected(&collected);
+
+	return errors;
+}
+
+static int check_memory_usage(void) {
+	const char** history = malloc(20000 * sizeof(const char*));
+	char buffer[64];
+	size_t count = 0, flat_size = 0, major, minor, patch, rc;
+	version_trie_t* trie;
+
+	/* typical release history: majors, minors, patch levels with release candidates */
+	for (major = 0; major < 10; major++) {
+		for (minor = 0; minor < 30; minor++) {
+			for (rc = 1; rc <= 3; rc++) {
+				snprintf(buffer, sizeof(buffer), "%d.%d.0rc%d", (int)major, (int)minor, (int)rc);
+				history[count++] = strdup(buffer);
+			}
+			for (patch = 0; patch < 48; patch++) {
+				snprintf(buffer, sizeof(buffer), "%d.%d.%d", (int)major, (int)minor, (int)patch);
+				history[count++] = strdup(buffer);
+			}
+		}
+	}
+
+	/* packed strings with pointers to them */
+	for (flat_size = 0, patch = 0; patch < count; patch++)
+		flat_size += strlen(history[patch]) + 1 + sizeof(const char*);
+
+	trie = version_trie_build(history, NULL, count, 0);
+
+	fprintf(stderr, "\nTest group: memory usage\n");
+	fprintf(stderr, "[ OK ] %d versions: %d bytes in trie, %d bytes flat\n", (int)count, (int)version_trie_memory_usage(trie), (int)flat_size);
+
+	version_trie_free(trie);
+	while (count > 0)
+		free((char*)history[--count]);
+	free(history);
+
+	return 0;
+}
+
+int main(void) {
+	version_trie_t* trie;
+	size_t values[COUNT(versions)];
+	size_t i;
+	int errors = 0;
+
+	for (i = 0; i < COUNT(versions); i++)
+		values[i] = i;
+
+	fprintf(stderr, "Test group: empty trie\n");
+	trie = version_trie_build(NULL, NULL, 0, 0);
+	errors += check_release(trie, 0, NULL, 0);
+	version_trie_free(trie);
+
+	fprintf(stderr, "\nTest group: releases\n");
+	trie = version_trie_build(versions, values, COUNT(versions), 0);
+	for (i = 0; i < COUNT(releases); i++)
+		errors += check_release(trie, COUNT(versions), releases[i], 0);
+	version_trie_free(trie);
+
+	fprintf(stderr, "\nTest group: releases, p is patch\n");
+	trie = version_trie_build(versions, values, COUNT(versions), VERSIONFLAG_P_IS_PATCH);
+	for (i = 0; i < COUNT(releases); i++)
+		errors += check_release(trie, COUNT(versions), releases[i], VERSIONFLAG_P_IS_PATCH);
+	version_trie_free(trie);
+
+	fprintf(stderr, "\nTest group: releases, any is patch\n");
+	trie = version_trie_build(versions, values, COUNT(versions), VERSIONFLAG_ANY_IS_PATCH);
+	for (i = 0; i < COUNT(releases); i++)
+		errors += check_release(trie, COUNT(versions), releases[i], VERSIONFLAG_ANY_IS_PATCH);
+	version_trie_free(trie);
+
+	errors += check_memory_usage();
+
+	return errors != 0;
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+/* Runs version_compare utility (path given as argument) in batch and
+ * filter modes on small inputs and checks its output and exit status */
+
+typedef struct {
+	const char* args;
+	const char* input;
+	const char* expected;
+	int fails;
+} test_case_t;
+
+static const test_case_t batch_cases[] = {
+	{ "-b", "", "", 0 },
+	{ "-b", "1.0 1.1\n1.1 1.0\n1.0 1.0.0\n", "<\n>\n=\n", 0 },
+	{ "-b", "1.0 < 1.1\n1.0 lt 1.1\n1.0 >= 1.1\n1.0 eq 1.0.0\n1.0 =< 1.0\n1.1 gt 1.0\n", "1\n1\n0\n1\n1\n1\n", 0 },
+	/* any whitespace separates fields */
+	{ "-b", "  1.0\t\t1.1  \r\n1.0\t=\t1.0\n", "<\n1\n", 0 },
+	/* malformed lines do not stop processing */
+	{ "-b", "1.0\n1.0 1.1 1.2\n1.0 ~ 1.1\n1.0 < 1.1 x\n\n1.0 1.1\n", "?\n?\n?\n?\n?\n<\n", 0 },
+	{ "-b", "1.0 1.0p1\n", ">\n", 0 },
+	{ "-p -b", "1.0 1.0p1\n", "<\n", 0 },
+	{ "-b", "1.0 1.0.foo\n", ">\n", 0 },
+	{ "-a -b", "1.0 1.0.foo\n", "<\n", 0 },
+	{ "-b 1.0", "", "", 1 },
+};
+
+#define FILTER_INPUT "0.9\n1.0alpha1\n1.0\n1.0.0\n1.1\n"
+
+static const test_case_t filter_cases[] = {
+	{ "-f '<' 1.0", FILTER_INPUT, "0.9\n1.0alpha1\n", 0 },
+	{ "-f lt 1.0", FILTER_INPUT, "0.9\n1.0alpha1\n", 0 },
+	{ "-f '<=' 1.0", FILTER_INPUT, "0.9\n1.0alpha1\n1.0\n1.0.0\n", 0 },
+	{ "-f '=<' 1.0", FILTER_INPUT, "0.9\n1.0alpha1\n1.0\n1.0.0\n", 0 },
+	{ "-f le 1.0", FILTER_INPUT, "0.9\n1.0alpha1\n1.0\n1.0.0\n", 0 },
+	{ "-f = 1.0", FILTER_INPUT, "1.0\n1.0.0\n", 0 },
+	{ "-f eq 1.0", FILTER_INPUT, "1.0\n1.0.0\n", 0 },
+	{ "-f '>=' 1.0", FILTER_INPUT, "1.0\n1.0.0\n1.1\n", 0 },
+	{ "-f '=>' 1.0", FILTER_INPUT, "1.0\n1.0.0\n1.1\n", 0 },
+	{ "-f ge 1.0", FILTER_INPUT, "1.0\n1.0.0\n1.1\n", 0 },
+	{ "-f '>' 1.0", FILTER_INPUT, "1.1\n", 0 },
+	{ "-f gt 1.0", FILTER_INPUT, "1.1\n", 0 },
+	/* pivot is parsed with the same flags */
+	{ "-f gt 1.0alpha1", FILTER_INPUT, "1.0\n1.0.0\n1.1\n", 0 },
+	/* line endings are stripped, lines are printed as is */
+	{ "-f ge 1.0", "1.0\r\n 1.1\n", "1.0\n 1.1\n", 0 },
+	{ "-f gt 1.0", "1.0p1\n", "", 0 },
+	{ "-p -f gt 1.0", "1.0p1\n", "1.0p1\n", 0 },
+	{ "-f gt 1.0", "1.0.foo\n", "", 0 },
+	{ "-a -f gt 1.0", "1.0.foo\n", "1.0.foo\n", 0 },
+	{ "-f '~' 1.0", FILTER_INPUT, "", 1 },
+	{ "-f lt", FILTER_INPUT, "", 1 },
+	{ "-f lt 1.0 2.0", FILTER_INPUT, "", 1 },
+	{ "-b -f lt 1.0", FILTER_INPUT, "", 1 },
+};
+
+#define COUNT(a) (sizeof(a)/sizeof(a[0]))
+
+static const char* input_path = "version_compare_test.txt";
+
+static int run_test(const char* version_compare, const test_case_t* test_case) {
+	char command[1024], output[1024];
+	size_t length;
+	FILE* file;
+	int status;
+
+	if ((file = fopen(input_path, "wb")) == NULL || fputs(test_case->input, file) == EOF || fclose(file) != 0) {
+		fprintf(stderr, "[FAIL] cannot write %s\n", input_path);
+		return 1;
+	}
+
+	snprintf(command, sizeof(command), "'%s' %s < %s 2>/dev/null", version_compare, test_case->args, input_path);
+	if ((file = popen(command, "r")) == NULL) {
+		fprintf(stderr, "[FAIL] cannot run %s\n", command);
+		return 1;
+	}
+	length = fread(output, 1, sizeof(output) - 1, file);
+	output[length] = '\0';
+	status = pclose(file);
+
+	if ((status != 0) != test_case->fails) {
+		fprintf(stderr, "[FAIL] version_compare %s: expected %s\n", test_case->args, test_case->fails ? "failure" : "success");
+		return 1;
+	}
+
+	if (strcmp(output, test_case->expected) != 0) {
+		fprintf(stderr, "[FAIL] version_compare %s: unexpected output:\n%s", test_case->args, output);
+		return 1;
+	}
+
+	fprintf(stderr, "[ OK ] version_compare %s\n", test_case->args);
+	return 0;
+}
+
+int main(int argc, char** argv) {
+	size_t i;
+	int errors = 0;
+
+	if (argc != 2) {
+		fprintf(stderr, "Usage: %s path/to/version_compare\n", argv[0]);
+		return 1;
+	}
+
+	fprintf(stderr, "Test group: batch mode\n");
+	for (i = 0; i < COUNT(batch_cases); i++)
+		errors += run_test(argv[1], &batch_cases[i]);
+
+	fprintf(stderr, "\nTest group: filter mode\n");
+	for (i = 0; i < COUNT(filter_cases); i++)
+		errors += run_test(argv[1], &filter_cases[i]);
+
+	remove(input_path);
+
+	return errors != 0;
+}
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/* Starts version_daemon utility (path given as argument) on a socket
+ * in the current directory and checks its responses */
+
+static const char* socket_path = "version_daemon_test.sock";
+
+/* pipelined in a single write, answered in order */
+static const char requests[] =
+	"compare 1.0 1.1\n"
+	"compare 1.0 eq 1.0.0\n"
+	"compare 1.0 > 1.1\n"
+	"sort 1.10 1.9 1.0alpha1 1.0\n"
+	"latest 1.0 1.10 1.9\n"
+	"filter ge 1.0 0.9 1.0 1.1 1.0alpha1\n"
+	"filter ~ 1.0 1.1\n"
+	"bogus\n"
+	"\n";
+
+static const char responses[] =
+	"<\n"
+	"1\n"
+	"0\n"
+	"1.0alpha1 1.0 1.9 1.10\n"
+	"1.10\n"
+	"1.0 1.1\n"
+	"error bad request\n"
+	"error bad request\n"
+	"error empty request\n";
+
+static int connect_daemon(void) {
+	struct sockaddr_un addr;
+	int fd;
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strcpy(addr.sun_path, socket_path);
+
+	if ((fd = socket(AF_UNIX, SOCK_STREAM, 0)) == -1)
+		return -1;
+	if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) == -1) {
+		close(fd);
+		return -1;
+	}
+
+	return fd;
+}
+
+/* retries while the daemon is starting up */
+static int wait_for_daemon(void) {
+	int attempt, fd;
+
+	for (attempt = 0; attempt < 500; attempt++) {
+		if ((fd = connect_daemon()) != -1)
+			return fd;
+		usleep(10000);
+	}
+
+	return -1;
+}
+
+static pid_t start_daemon(const char* version_daemon) {
+	pid_t pid = fork();
+
+	if (pid == 0) {
+		execl(version_daemon, version_daemon, socket_path, (char*)NULL);
+		_exit(127);
+	}
+
+	return pid;
+}
+
+/* exit status, or -1 if it's still running after a while (then it's killed) */
+static int wait_for_exit(pid_t pid) {
+	int attempt, status;
+
+	for (attempt = 0; attempt < 500; attempt++) {
+		if (waitpid(pid, &status, WNOHANG) == pid)
+			return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+		usleep(10000);
+	}
+
+	kill(pid, SIGKILL);
+	waitpid(pid, &status, 0);
+	return -1;
+}
+
+static int stop_daemon(pid_t pid) {
+	int status;
+
+	kill(pid, SIGTERM);
+	if (waitpid(pid, &status, 0) != pid)
+		return -1;
+	return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+static int check_requests(const char* what) {
+	char output[1024];
+	size_t length = 0;
+	ssize_t nread;
+	int fd;
+
+	if ((fd = wait_for_daemon()) == -1) {
+		fprintf(stderr, "[FAIL] %s: cannot connect to daemon\n", what);
+		return 1;
+	}
+
+	if (write(fd, requests, sizeof(requests) - 1) != (ssize_t)(sizeof(requests) - 1)) {
+		fprintf(stderr, "[FAIL] %s: cannot send requests\n", what);
+		close(fd);
+		return 1;
+	}
+	shutdown(fd, SHUT_WR);
+
+	while (length < sizeof(output) - 1 && (nread = read(fd, output + length, sizeof(output) - 1 - length)) > 0)
+		length += (size_t)nread;
+	output[length] = '\0';
+	close(fd);
+
+	if (strcmp(output, responses) != 0) {
+		fprintf(stderr, "[FAIL] %s: unexpected responses:\n%s", what, output);
+		return 1;
+	}
+
+	fprintf(stderr, "[ OK ] %s\n", what);
+	return 0;
+}
+
+static int check(const char* what, int expected, int result) {
+	if (expected == result) {
+		fprintf(stderr, "[ OK ] %s\n", what);
+		return 0;
+	} else {
+		fprintf(stderr, "[FAIL] %s: expected %d, got %d\n", what, expected, result);
+		return 1;
+	}
+}
+
+/* socket file which nobody listens on, like one left by a killed daemon */
+static int make_stale_socket(void) {
+	struct sockaddr_un addr;
+	int fd;
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strcpy(addr.sun_path, socket_path);
+
+	if ((fd = socket(AF_UNIX, SOCK_STREAM, 0)) == -1)
+		return 0;
+	if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) == -1) {
+		close(fd);
+		return 0;
+	}
+	close(fd);
+	return 1;
+}
+
+int main(int argc, char** argv) {
+	struct stat st;
+	pid_t pid, second;
+	int errors = 0;
+
+	if (argc != 2) {
+		fprintf(stderr, "Usage: %s path/to/version_daemon\n", argv[0]);
+		return 1;
+	}
+
+	unlink(socket_path);
+
+	fprintf(stderr, "Test group: requests\n");
+	pid = start_daemon(argv[1]);
+	errors += check_requests("pipelined requests");
+	errors += check_requests("requests from another client");
+
+	fprintf(stderr, "\nTest group: second instance\n");
+	second = start_daemon(argv[1]);
+	errors += check("second instance fails", 1, wait_for_exit(second) > 0);
+	errors += check_requests("first instance still serves");
+
+	fprintf(stderr, "\nTest group: shutdown\n");
+	errors += check("exit status", 0, stop_daemon(pid));
+	errors += check("socket removed", 1, stat(socket_path, &st) == -1 && errno == ENOENT);
+
+	fprintf(stderr, "\nTest group: stale socket\n");
+	errors += check("stale socket created", 1, make_stale_socket());
+	pid = start_daemon(argv[1]);
+	errors += check_requests("stale socket replaced");
+	errors += check("exit status", 0, stop_daemon(pid));
+
+	unlink(socket_path);
+
+	return errors != 0;
+}
@@ -0,0 +1,137 @@
+// Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#define LIBVERSION_NO_DEPRECATED // disable deprecated APIs
+
+#include <libversion/version.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// Checks that C++ wrappers agree with version_compare4()
+
+static const char* versions[] = {
+	"", "0", "1", "1.0", "1.0.0", "1.0alpha1", "1.0a", "1.0p1", "1.0patch1", "1.0pre1",
+	"1.0.1", "2.0", "10", "0.99", "1.0rc1", "a", "z",
+	"123456789012345678901234567890",
+	"1.2.3.4.5.6.7.8.9.10.11.12.13.14.15.16.17.18.19.20.21.22.23.24.25.26.27.28.29.30"
+	".31.32.33.34.35.36.37.38.39.40.41.42.43.44.45.46.47.48.49.50.51.52.53.54.55.56.57.58.59.60",
+};
+
+static int sign(int v) {
+	return (v > 0) - (v < 0);
+}
+
+static int sign(std::strong_ordering v) {
+	return v < 0 ? -1 : v > 0 ? 1 : 0;
+}
+
+static int errors = 0;
+
+static void check(bool ok, const std::string& what) {
+	if (ok) {
+		std::cerr << "[ OK ] " << what << "\n";
+	} else {
+		std::cerr << "[FAIL] " << what << "\n";
+		errors++;
+	}
+}
+
+template<int Flags1, int Flags2>
+static void check_pairs() {
+	int local_errors = 0, checks = 0;
+
+	for (const char* s1: versions) {
+		for (const char* s2: versions) {
+			const int expected = sign(version_compare4(s1, s2, Flags1, Flags2));
+
+			libversion::basic_version<Flags1> v1(s1);
+			libversion::basic_version<Flags2> v2(s2);
+
+			// views over strings which are not NUL terminated
+			const std::string padded1 = std::string(s1) + "\xff" "9";
+			const std::string padded2 = std::string(s2) + "\xff" "9";
+			libversion::basic_version_view<Flags1> w1(std::string_view(padded1).substr(0, padded1.size() - 2));
+			libversion::basic_version_view<Flags2> w2(std::string_view(padded2).substr(0, padded2.size() - 2));
+
+			if (sign(v1 <=> v2) != expected || (v1 == v2) != (expected == 0) || (v1 < v2) != (expected < 0) ||
+					sign(w1 <=> w2) != expected || (w1 == w2) != (expected == 0) ||
+					sign(v1 <=> w2) != expected || sign(w1 <=> v2) != expected || (w1 == v2) != (expected == 0)) {
+				std::cerr << "[FAIL] \"" << s1 << "\" (0x" << std::hex << Flags1 << ") vs \"" << s2 << "\" (0x" << Flags2 << std::dec << ")\n";
+				local_errors++;
+			}
+
+			if (expected == 0 && (std::hash<decltype(v1)>()(v1) != std::hash<decltype(v2)>()(v2) || std::hash<decltype(w1)>()(w1) != std::hash<decltype(v1)>()(v1))) {
+				std::cerr << "[FAIL] hashes of \"" << s1 << "\" and \"" << s2 << "\" differ\n";
+				local_errors++;
+			}
+
+			checks++;
+		}
+	}
+
+	check(local_errors == 0, std::to_string(checks) + " comparisons with flags 0x" + std::to_string(Flags1) + ", 0x" + std::to_string(Flags2));
+	errors += local_errors;
+}
+
+int main() {
+	static_assert(std::is_same_v<decltype(libversion::version() <=> libversion::version()), std::strong_ordering>);
+	static_assert(std::is_same_v<decltype(libversion::version_view() <=> libversion::version_view()), std::strong_ordering>);
+	static_assert(std::is_nothrow_constructible_v<libversion::version_view, std::string_view>);
+
+	std::cerr << "Test group: comparisons\n";
+	check_pairs<0, 0>();
+	check_pairs<libversion::flags::p_is_patch, 0>();
+	check_pairs<libversion::flags::any_is_patch, libversion::flags::p_is_patch>();
+	check_pairs<0, libversion::flags::lower_bound>();
+	check_pairs<libversion::flags::upper_bound, libversion::flags::lower_bound>();
+
+	std::cerr << "\nTest group: containers\n";
+	{
+		std::vector<libversion::version> sorted;
+		for (const char* s: versions) {
+			sorted.emplace_back(s);
+		}
+		std::sort(sorted.begin(), sorted.end());
+		check(std::is_sorted(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) { return version_compare2(a.str().c_str(), b.str().c_str()) < 0; }), "sorted vector");
+
+		std::unordered_set<libversion::version> set;
+		for (const char* s: {"1.0", "1.0.0", "1.0.0.0", "1.0a", "1.0A"}) {
+			set.emplace(s);
+		}
+		check(set.size() == 2, "equal versions are deduplicated in unordered_set");
+		check(set.count(libversion::version("1")) == 1, "unordered_set lookup");
+	}
+
+	std::cerr << "\nTest group: accessors\n";
+	{
+		libversion::basic_version<libversion::flags::p_is_patch> v(std::string_view("1.0p1"));
+		check(v.str() == "1.0p1", "str()");
+		check(v.view().str() == "1.0p1", "view()");
+		check(v.key() == libversion::basic_version_view<libversion::flags::p_is_patch>("1.0p1").key(), "key() of version and view");
+		check(v > libversion::version("1.0"), "p is patch");
+		check(libversion::version() == libversion::version("0"), "default constructed version");
+	}
+
+	return errors != 0;
+}
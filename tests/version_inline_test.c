@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <libversion/version.h>
+#include <libversion/version_inline.h>
+
+#include <stdio.h>
+
+/* Every comparison done by compare_test.c is checked against the
+ * amalgamated inline implementation */
+static int disagreements = 0;
+static int checks = 0;
+
+static int sign(int v) {
+	return (v > 0) - (v < 0);
+}
+
+static void check(const char* v1, const char* v2, int v1_flags, int v2_flags, int expected, int result) {
+	if (sign(result) != sign(expected)) {
+		fprintf(stderr, "[FAIL] \"%s\" (0x%x) vs \"%s\" (0x%x): library gives %d, inline gives %d\n", v1, v1_flags, v2, v2_flags, expected, result);
+		disagreements++;
+	}
+	checks++;
+}
+
+static int checked_compare4(const char* v1, const char* v2, int v1_flags, int v2_flags) {
+	int expected = version_compare4(v1, v2, v1_flags, v2_flags);
+
+	check(v1, v2, v1_flags, v2_flags, expected, version_compare4_inline(v1, v2, v1_flags, v2_flags));
+	if (v1_flags == 0 && v2_flags == 0)
+		check(v1, v2, 0, 0, expected, version_compare2_inline(v1, v2));
+
+	return expected;
+}
+
+static int checked_compare2(const char* v1, const char* v2) {
+	return checked_compare4(v1, v2, 0, 0);
+}
+
+#define version_compare2 checked_compare2
+#define version_compare4 checked_compare4
+#define main compare_test_main
+#include "compare_test.c"
+#undef main
+
+int main(void) {
+	int errors = compare_test_main();
+
+	fprintf(stderr, "\nTest group: inline agreement\n");
+	fprintf(stderr, "[%s] %d comparisons\n", disagreements ? "FAIL" : " OK ", checks);
+
+	return errors != 0 || disagreements != 0;
+}
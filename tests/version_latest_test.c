@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Runs version_latest utility (path given as argument) on small inputs
+ * and checks its output */
+
+typedef struct {
+	const char* args;
+	const char* input;
+	const char* expected;
+} test_case_t;
+
+static const test_case_t test_cases[] = {
+	{ "", "a\t1.0\na\t1.10\nb\t2.0alpha1\nb\t1.9\na\t1.9\n", "a\t1.10\nb\t2.0alpha1\n" },
+	/* remaining fields are ignored, lines without version are skipped */
+	{ "", "a\t1.0\tx\na\t0.9\tyy\nb\n", "a\t1.0\n" },
+	/* equal versions are only listed once */
+	{ "-n 2", "a\t1.0\na\t1.10\nb\t2.0alpha1\na\t1.10\nb\t1.9\na\t1.9\n", "a\t1.10\na\t1.9\nb\t2.0alpha1\nb\t1.9\n" },
+	{ "-n 5", "a\t1.0\na\t1.1\n", "a\t1.1\na\t1.0\n" },
+	{ "-l", "a\t1.0\na\t1.10\nb\t2.0alpha1\nb\t1.9\na\t1.9\n", "a\t1.0\nb\t1.9\n" },
+	{ "-l -n 2", "a\t1.0\na\t1.10\na\t1.9\n", "a\t1.0\na\t1.9\n" },
+	{ "", "a\t1.0\na\t1.0p1\n", "a\t1.0\n" },
+	{ "-p", "a\t1.0\na\t1.0p1\n", "a\t1.0p1\n" },
+	{ "", "a\t1.0\na\t1.0.foo\n", "a\t1.0\n" },
+	{ "-a", "a\t1.0\na\t1.0.foo\n", "a\t1.0.foo\n" },
+	{ "-t ,", "a,1.0\na,1.1\n", "a,1.1\n" },
+};
+
+#define COUNT(a) (sizeof(a)/sizeof(a[0]))
+
+#define PARALLEL_LINES 20000
+
+static const char* input_path = "version_latest_test.txt";
+
+/* returns output of successful run, which should be freed */
+static char* run(const char* version_latest, const char* args, const char* input) {
+	char command[1024];
+	char* output = NULL;
+	size_t length = 0, capacity = 0;
+	FILE* file;
+
+	if ((file = fopen(input_path, "wb")) == NULL || fputs(input, file) == EOF || fclose(file) != 0) {
+		fprintf(stderr, "[FAIL] cannot write %s\n", input_path);
+		return NULL;
+	}
+
+	snprintf(command, sizeof(command), "'%s' %s %s", version_latest, args, input_path);
+	if ((file = popen(command, "r")) == NULL) {
+		fprintf(stderr, "[FAIL] cannot run %s\n", command);
+		return NULL;
+	}
+
+	do {
+		if (length + 1 >= capacity) {
+			capacity = capacity ? capacity * 2 : 4096;
+			output = realloc(output, capacity);
+		}
+		length += fread(output + length, 1, capacity - length - 1, file);
+	} while (!feof(file) && !ferror(file));
+	output[length] = '\0';
+
+	if (pclose(file) != 0) {
+		fprintf(stderr, "[FAIL] version_latest %s: failed\n", args);
+		free(output);
+		return NULL;
+	}
+
+	return output;
+}
+
+static int run_test(const char* version_latest, const test_case_t* test_case) {
+	char* output = run(version_latest, test_case->args, test_case->input);
+
+	if (output == NULL)
+		return 1;
+
+	if (strcmp(output, test_case->expected) != 0) {
+		fprintf(stderr, "[FAIL] version_latest %s: unexpected output:\n%s", test_case->args, output);
+		free(output);
+		return 1;
+	}
+
+	fprintf(stderr, "[ OK ] version_latest %s\n", test_case->args);
+	free(output);
+	return 0;
+}
+
+/* enough lines for many batches per thread; keys and versions repeat */
+static char* make_parallel_input(void) {
+	char* input = malloc(PARALLEL_LINES * 32);
+	size_t length = 0, i;
+
+	for (i = 0; i < PARALLEL_LINES; i++)
+		length += (size_t)sprintf(input + length, "pkg%d\t%d.%d%s\n", (int)(i % 997), (int)(i % 13), (int)(i % 7), i % 5 ? "" : "rc1");
+
+	return input;
+}
+
+static int parallel_test(const char* version_latest, const char* input, const char* args, const char* parallel_args) {
+	char* expected = run(version_latest, args, input);
+	char* output = run(version_latest, parallel_args, input);
+	int errors = 0;
+
+	if (expected == NULL || output == NULL) {
+		errors++;
+	} else if (strcmp(output, expected) != 0) {
+		fprintf(stderr, "[FAIL] version_latest %s: output differs from version_latest %s\n", parallel_args, args);
+		errors++;
+	} else {
+		fprintf(stderr, "[ OK ] version_latest %s\n", parallel_args);
+	}
+
+	free(expected);
+	free(output);
+	return errors;
+}
+
+int main(int argc, char** argv) {
+	char* input;
+	size_t i;
+	int errors = 0;
+
+	if (argc != 2) {
+		fprintf(stderr, "Usage: %s path/to/version_latest\n", argv[0]);
+		return 1;
+	}
+
+	fprintf(stderr, "Test group: latest versions\n");
+	for (i = 0; i < COUNT(test_cases); i++)
+		errors += run_test(argv[1], &test_cases[i]);
+
+	fprintf(stderr, "\nTest group: threads\n");
+	input = make_parallel_input();
+	errors += parallel_test(argv[1], input, "", "-j 4");
+	errors += parallel_test(argv[1], input, "-n 3", "-n 3 -j 3");
+	errors += parallel_test(argv[1], input, "-l -n 2", "-l -n 2 -j 2");
+	free(input);
+
+	remove(input_path);
+
+	return errors != 0;
+}
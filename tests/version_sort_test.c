@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+/* Runs version_sort utility (path given as argument) on small inputs
+ * and checks its output */
+
+typedef struct {
+	const char* args;
+	const char* input;
+	const char* expected;
+} test_case_t;
+
+static const test_case_t test_cases[] = {
+	{ "", "1.10\n1.9\n1.0\n", "1.0\n1.9\n1.10\n" },
+	/* whole line is the version */
+	{ "", "1.0\t5\n1.0\t10\n", "1.0\t5\n1.0\t10\n" },
+	/* first field, split with default delimiter */
+	{ "-f 1", "1.0\t5\n1.0\t10\n", "1.0\t10\n1.0\t5\n" },
+	{ "-t '\\t' -f 1", "1.0\t5\n1.0\t10\n", "1.0\t10\n1.0\t5\n" },
+	{ "-f 2", "a\t1.10\nb\t1.9\n", "b\t1.9\na\t1.10\n" },
+	{ "-t , -f 2 -k 1", "b,1.0\na,1.0\nc,0.9\n", "c,0.9\na,1.0\nb,1.0\n" },
+};
+
+#define COUNT(a) (sizeof(a)/sizeof(a[0]))
+
+static const char* input_path = "version_sort_test.txt";
+
+static int run_test(const char* version_sort, const test_case_t* test_case) {
+	char command[1024], output[1024];
+	size_t length;
+	FILE* file;
+
+	if ((file = fopen(input_path, "wb")) == NULL || fputs(test_case->input, file) == EOF || fclose(file) != 0) {
+		fprintf(stderr, "[FAIL] cannot write %s\n", input_path);
+		return 1;
+	}
+
+	snprintf(command, sizeof(command), "'%s' %s %s", version_sort, test_case->args, input_path);
+	if ((file = popen(command, "r")) == NULL) {
+		fprintf(stderr, "[FAIL] cannot run %s\n", command);
+		return 1;
+	}
+	length = fread(output, 1, sizeof(output) - 1, file);
+	output[length] = '\0';
+
+	if (pclose(file) != 0 || strcmp(output, test_case->expected) != 0) {
+		fprintf(stderr, "[FAIL] version_sort %s: unexpected output:\n%s", test_case->args, output);
+		return 1;
+	}
+
+	fprintf(stderr, "[ OK ] version_sort %s\n", test_case->args);
+	return 0;
+}
+
+int main(int argc, char** argv) {
+	size_t i;
+	int errors = 0;
+
+	if (argc != 2) {
+		fprintf(stderr, "Usage: %s path/to/version_sort\n", argv[0]);
+		return 1;
+	}
+
+	fprintf(stderr, "Test group: sorting\n");
+	for (i = 0; i < COUNT(test_cases); i++)
+		errors += run_test(argv[1], &test_cases[i]);
+
+	remove(input_path);
+
+	return errors != 0;
+}
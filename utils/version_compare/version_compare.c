@@ -21,6 +21,7 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 
@@ -33,6 +34,8 @@ static void print_version(void) {
 
 static void print_usage(const char* progname) {
 	fprintf(stderr, "Usage: %s [-pa] version1 [op] version2\n", progname);
+	fprintf(stderr, "       %s [-pa] -b\n", progname);
+	fprintf(stderr, "       %s [-pa] -f op version\n", progname);
 	fprintf(stderr, "\n");
 	fprintf(stderr, " op       - if specified (supports <, <=, =, >=, >, lt, le, eq, ge, gt),\n");
 	fprintf(stderr, "            the utility would exit with zero (success) status code if the\n");
@@ -41,6 +44,12 @@ static void print_usage(const char* progname) {
 	fprintf(stderr, "\n");
 	fprintf(stderr, " -p       - 'p' letter is treated as 'patch' instead of 'pre'\n");
 	fprintf(stderr, " -a       - any alphabetic characters are treated as post-release\n");
+	fprintf(stderr, " -b       - batch mode: read lines of form 'version1 [op] version2'\n");
+	fprintf(stderr, "            from stdin, and for each one print either <, =, or >, or,\n");
+	fprintf(stderr, "            if op is specified, 1 if the condition is satisfied and 0\n");
+	fprintf(stderr, "            otherwise (? is printed for malformed lines)\n");
+	fprintf(stderr, " -f       - filter mode: read versions from stdin, one per line, and\n");
+	fprintf(stderr, "            print ones which satisfy 'candidate op version' condition\n");
 	fprintf(stderr, "\n");
 	fprintf(stderr, " -h, -?   - print usage and exit\n");
 	fprintf(stderr, " -v       - print version and exit\n");
@@ -50,11 +59,159 @@ static int streq(const char* a, const char* b) {
 	return strcmp(a, b) == 0;
 }
 
+enum {
+	OP_INVALID,
+	OP_LT,
+	OP_LE,
+	OP_EQ,
+	OP_GE,
+	OP_GT,
+};
+
+static int parse_op(const char* op) {
+	if (streq(op, "<") || streq(op, "lt"))
+		return OP_LT;
+	else if (streq(op, "<=") || streq(op, "=<") || streq(op, "le"))
+		return OP_LE;
+	else if (streq(op, "=") || streq(op, "eq"))
+		return OP_EQ;
+	else if (streq(op, ">=") || streq(op, "=>") || streq(op, "ge"))
+		return OP_GE;
+	else if (streq(op, ">") || streq(op, "gt"))
+		return OP_GT;
+	return OP_INVALID;
+}
+
+static int check_op(int op, int result) {
+	switch (op) {
+	case OP_LT: return result < 0;
+	case OP_LE: return result <= 0;
+	case OP_EQ: return result == 0;
+	case OP_GE: return result >= 0;
+	case OP_GT: return result > 0;
+	default: return 0;
+	}
+}
+
+static const char* result_char(int result) {
+	return result < 0 ? "<" : result > 0 ? ">" : "=";
+}
+
+/* splits line into at most max_fields whitespace separated fields, in place */
+static size_t split_fields(char* line, char** fields, size_t max_fields) {
+	size_t count = 0;
+
+	while (1) {
+		line += strspn(line, " \t\r\n");
+		if (*line == '\0')
+			return count;
+		if (count == max_fields)
+			return max_fields + 1;
+		fields[count++] = line;
+		line += strcspn(line, " \t\r\n");
+		if (*line != '\0')
+			*line++ = '\0';
+	}
+}
+
+static int batch(int flags) {
+	static char output_buffer[65536];
+	char* line = NULL;
+	char* fields[3];
+	size_t line_size = 0, lineno = 0;
+	int op;
+
+	setvbuf(stdout, output_buffer, _IOFBF, sizeof(output_buffer));
+
+	while (getline(&line, &line_size, stdin) != -1) {
+		lineno++;
+		switch (split_fields(line, fields, 3)) {
+		case 2:
+			fputs(result_char(version_compare4(fields[0], fields[1], flags, flags)), stdout);
+			break;
+		case 3:
+			if ((op = parse_op(fields[1])) != OP_INVALID) {
+				putchar(check_op(op, version_compare4(fields[0], fields[2], flags, flags)) ? '1' : '0');
+				break;
+			}
+			/* fallthrough */
+		default:
+			fprintf(stderr, "line %lu: malformed input\n", (unsigned long)lineno);
+			putchar('?');
+		}
+		putchar('\n');
+	}
+
+	free(line);
+	return fflush(stdout) != 0 || ferror(stdin);
+}
+
+/* makes sort key into growing buffer, returns its length or 0 on allocation failure */
+static size_t make_key(const char* v, int flags, unsigned char** key, size_t* key_size) {
+	size_t length = version_sort_key(v, flags, *key, *key_size);
+	unsigned char* new_key;
+
+	if (length > *key_size) {
+		if ((new_key = realloc(*key, length)) == NULL)
+			return 0;
+		*key = new_key;
+		*key_size = length;
+		version_sort_key(v, flags, *key, *key_size);
+	}
+
+	return length;
+}
+
+static int compare_keys(const unsigned char* k1, size_t k1_len, const unsigned char* k2, size_t k2_len) {
+	int res = memcmp(k1, k2, k1_len < k2_len ? k1_len : k2_len);
+	if (res != 0)
+		return res;
+	return (k1_len > k2_len) - (k1_len < k2_len);
+}
+
+/* pivot and each candidate are parsed only once, and compared as sort keys */
+static int filter(int op, const char* pivot, int flags) {
+	static char output_buffer[65536];
+	unsigned char* pivot_key = NULL;
+	unsigned char* key = NULL;
+	size_t pivot_key_size = 0, pivot_key_length, key_size = 0, key_length;
+	char* line = NULL;
+	size_t line_size = 0;
+	ssize_t line_length;
+	int res = 1;
+
+	setvbuf(stdout, output_buffer, _IOFBF, sizeof(output_buffer));
+
+	if ((pivot_key_length = make_key(pivot, flags, &pivot_key, &pivot_key_size)) == 0)
+		goto out;
+
+	while ((line_length = getline(&line, &line_size, stdin)) != -1) {
+		while (line_length > 0 && (line[line_length - 1] == '\n' || line[line_length - 1] == '\r'))
+			line[--line_length] = '\0';
+
+		if ((key_length = make_key(line, flags, &key, &key_size)) == 0)
+			goto out;
+
+		if (check_op(op, compare_keys(key, key_length, pivot_key, pivot_key_length))) {
+			fputs(line, stdout);
+			putchar('\n');
+		}
+	}
+
+	res = ferror(stdin) != 0;
+
+out:
+	free(line);
+	free(key);
+	free(pivot_key);
+	return fflush(stdout) != 0 || res;
+}
+
 int main(int argc, char** argv) {
-	int ch, result, flags = 0;
+	int ch, result, op, flags = 0, batch_mode = 0, filter_mode = 0;
 	const char* progname = argv[0];
 
-	while ((ch = getopt(argc, argv, "pahv")) != -1) {
+	while ((ch = getopt(argc, argv, "pabfhv")) != -1) {
 		switch (ch) {
 		case 'p':
 			flags |= VERSIONFLAG_P_IS_PATCH;
@@ -62,6 +219,12 @@ int main(int argc, char** argv) {
 		case 'a':
 			flags |= VERSIONFLAG_ANY_IS_PATCH;
 			break;
+		case 'b':
+			batch_mode = 1;
+			break;
+		case 'f':
+			filter_mode = 1;
+			break;
 		case 'h':
 		case '?':
 			print_usage(progname);
@@ -78,30 +241,18 @@ int main(int argc, char** argv) {
 	argc -= optind;
 	argv += optind;
 
-	if (argc == 2) {
+	if (batch_mode || filter_mode) {
+		if (batch_mode && !filter_mode && argc == 0)
+			return batch(flags);
+		if (filter_mode && !batch_mode && argc == 2 && (op = parse_op(argv[0])) != OP_INVALID)
+			return filter(op, argv[1], flags);
+	} else if (argc == 2) {
 		result = version_compare4(argv[0], argv[1], flags, flags);
-
-		if (result < 0)
-			printf("<\n");
-		else if (result > 0)
-			printf(">\n");
-		else
-			printf("=\n");
-
+		printf("%s\n", result_char(result));
 		return 0;
-	} else if (argc == 3) {
+	} else if (argc == 3 && (op = parse_op(argv[1])) != OP_INVALID) {
 		result = version_compare4(argv[0], argv[2], flags, flags);
-
-		if (streq(argv[1], "<") || streq(argv[1], "lt"))
-			return !(result < 0);
-		else if (streq(argv[1], "<=") || streq(argv[1], "=<") || streq(argv[1], "le"))
-			return !(result <= 0);
-		else if (streq(argv[1], "=") || streq(argv[1], "=") || streq(argv[1], "eq"))
-			return !(result == 0);
-		else if (streq(argv[1], ">=") || streq(argv[1], "=>") || streq(argv[1], "ge"))
-			return !(result >= 0);
-		else if (streq(argv[1], ">") || streq(argv[1], "gt"))
-			return !(result > 0);
+		return !check_op(op, result);
 	}
 
 	print_usage(progname);
@@ -0,0 +1,525 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <libversion/cache.h>
+#include <libversion/config.h>
+#include <libversion/version.h>
+
+/* Protocol: each request is a line of space separated words, and
+ * each is answered with exactly one line, in order:
+ *
+ *   compare v1 v2           -> <, = or >
+ *   compare v1 op v2        -> 1 if condition is satisfied, 0 otherwise
+ *   sort v1 v2 ...          -> versions in ascending order
+ *   latest v1 v2 ...        -> the greatest version
+ *   filter op pivot v1 ...  -> versions v satisfying 'v op pivot'
+ *   error <message>         -  response to malformed request
+ *
+ * Clients may pipeline requests; everything read at once is processed
+ * in a batch and answered with a single write. All parsing goes
+ * through a shared parse cache, so frequently seen versions are
+ * only parsed once. */
+
+enum {
+	READ_SIZE = 65536,
+	MAX_LINE_LENGTH = 1024 * 1024,
+	MAX_PENDING_OUTPUT = 4 * 1024 * 1024,
+	DEFAULT_CACHE_SIZE = 64 * 1024 * 1024,
+};
+
+enum {
+	OP_INVALID,
+	OP_LT,
+	OP_LE,
+	OP_EQ,
+	OP_GE,
+	OP_GT,
+};
+
+typedef struct {
+	char* data;
+	size_t size;
+	size_t capacity;
+} buffer_t;
+
+typedef struct {
+	int fd;
+	int eof; /* client is done sending, drop it once responses are written */
+	buffer_t input;
+	buffer_t output;
+} client_t;
+
+typedef struct {
+	version_cache_t* cache;
+	int flags;
+	char** fields;
+	size_t fields_capacity;
+} daemon_t;
+
+static volatile sig_atomic_t terminate = 0;
+
+/* qsort() has no context argument, and the daemon is single threaded */
+static daemon_t* sort_daemon;
+
+static void handle_signal(int sig) {
+	(void)sig;
+	terminate = 1;
+}
+
+static int buffer_append(buffer_t* buffer, const char* data, size_t length) {
+	size_t capacity = buffer->capacity ? buffer->capacity : 256;
+	char* new_data;
+
+	while (capacity - buffer->size < length)
+		capacity *= 2;
+
+	if (capacity != buffer->capacity) {
+		if ((new_data = realloc(buffer->data, capacity)) == NULL)
+			return 0;
+		buffer->data = new_data;
+		buffer->capacity = capacity;
+	}
+
+	memcpy(buffer->data + buffer->size, data, length);
+	buffer->size += length;
+	return 1;
+}
+
+static int buffer_append_string(buffer_t* buffer, const char* str) {
+	return buffer_append(buffer, str, strlen(str));
+}
+
+static void buffer_consume(buffer_t* buffer, size_t length) {
+	memmove(buffer->data, buffer->data + length, buffer->size - length);
+	buffer->size -= length;
+}
+
+static void buffer_free(buffer_t* buffer) {
+	free(buffer->data);
+}
+
+static int streq(const char* a, const char* b) {
+	return strcmp(a, b) == 0;
+}
+
+/* same spellings as version_compare accepts */
+static int parse_op(const char* op) {
+	if (streq(op, "<") || streq(op, "lt"))
+		return OP_LT;
+	else if (streq(op, "<=") || streq(op, "=<") || streq(op, "le"))
+		return OP_LE;
+	else if (streq(op, "=") || streq(op, "eq"))
+		return OP_EQ;
+	else if (streq(op, ">=") || streq(op, "=>") || streq(op, "ge"))
+		return OP_GE;
+	else if (streq(op, ">") || streq(op, "gt"))
+		return OP_GT;
+	return OP_INVALID;
+}
+
+static int check_op(int op, int result) {
+	switch (op) {
+	case OP_LT: return result < 0;
+	case OP_LE: return result <= 0;
+	case OP_EQ: return result == 0;
+	case OP_GE: return result >= 0;
+	case OP_GT: return result > 0;
+	default: return 0;
+	}
+}
+
+static int compare(daemon_t* daemon, const char* v1, const char* v2) {
+	return version_cache_compare4(daemon->cache, v1, v2, daemon->flags, daemon->flags);
+}
+
+static int compare_for_sort(const void* a, const void* b) {
+	const char* va = *(const char* const*)a;
+	const char* vb = *(const char* const*)b;
+	int res = compare(sort_daemon, va, vb);
+	if (res != 0)
+		return res;
+	return strcmp(va, vb);  /* fallback to stringwise comparison for stable ordering */
+}
+
+/* splits line into space separated fields in place, returns number of fields or -1 */
+static long split_fields(daemon_t* daemon, char* line) {
+	size_t count = 0;
+	char** fields;
+
+	while (1) {
+		line += strspn(line, " \t\r");
+		if (*line == '\0')
+			return (long)count;
+
+		if (count == daemon->fields_capacity) {
+			size_t capacity = daemon->fields_capacity ? daemon->fields_capacity * 2 : 64;
+			if ((fields = realloc(daemon->fields, capacity * sizeof(char*))) == NULL)
+				return -1;
+			daemon->fields = fields;
+			daemon->fields_capacity = capacity;
+		}
+
+		daemon->fields[count++] = line;
+		line += strcspn(line, " \t\r");
+		if (*line != '\0')
+			*line++ = '\0';
+	}
+}
+
+static int append_versions(buffer_t* output, char** versions, size_t count) {
+	size_t i;
+	for (i = 0; i < count; i++)
+		if ((i > 0 && !buffer_append(output, " ", 1)) || !buffer_append_string(output, versions[i]))
+			return 0;
+	return 1;
+}
+
+static int process_request(daemon_t* daemon, char* line, buffer_t* output) {
+	long nfields = split_fields(daemon, line);
+	char** fields = daemon->fields;
+	size_t count, i, latest, matched;
+	const char* pivot;
+	int op;
+
+	if (nfields < 0)
+		return buffer_append_string(output, "error out of memory\n");
+	if (nfields == 0)
+		return buffer_append_string(output, "error empty request\n");
+
+	count = (size_t)nfields;
+
+	if (streq(fields[0], "compare") && count == 3) {
+		int res = compare(daemon, fields[1], fields[2]);
+		return buffer_append_string(output, res < 0 ? "<\n" : res > 0 ? ">\n" : "=\n");
+	} else if (streq(fields[0], "compare") && count == 4 && (op = parse_op(fields[2])) != OP_INVALID) {
+		return buffer_append_string(output, check_op(op, compare(daemon, fields[1], fields[3])) ? "1\n" : "0\n");
+	} else if (streq(fields[0], "sort")) {
+		sort_daemon = daemon;
+		qsort(fields + 1, count - 1, sizeof(char*), compare_for_sort);
+		return append_versions(output, fields + 1, count - 1) && buffer_append(output, "\n", 1);
+	} else if (streq(fields[0], "latest") && count >= 2) {
+		for (latest = 1, i = 2; i < count; i++)
+			if (compare(daemon, fields[i], fields[latest]) > 0)
+				latest = i;
+		return buffer_append_string(output, fields[latest]) && buffer_append(output, "\n", 1);
+	} else if (streq(fields[0], "filter") && count >= 3 && (op = parse_op(fields[1])) != OP_INVALID) {
+		/* matching versions are moved to the front, over the request words */
+		pivot = fields[2];
+		for (matched = 0, i = 3; i < count; i++)
+			if (check_op(op, compare(daemon, fields[i], pivot)))
+				fields[matched++] = fields[i];
+		return append_versions(output, fields, matched) && buffer_append(output, "\n", 1);
+	}
+
+	return buffer_append_string(output, "error bad request\n");
+}
+
+/* processes all complete lines in the input buffer, returns 0 if the client should be dropped */
+static int process_input(daemon_t* daemon, client_t* client) {
+	size_t start = 0;
+	char* end;
+
+	while ((end = memchr(client->input.data + start, '\n', client->input.size - start)) != NULL) {
+		*end = '\0';
+		if (!process_request(daemon, client->input.data + start, &client->output))
+			return 0;
+		start = end - client->input.data + 1;
+	}
+
+	buffer_consume(&client->input, start);
+
+	return client->input.size <= MAX_LINE_LENGTH;
+}
+
+static int flush_output(client_t* client) {
+	ssize_t written;
+
+	while (client->output.size > 0) {
+		written = write(client->fd, client->output.data, client->output.size);
+		if (written < 0)
+			return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+		buffer_consume(&client->output, (size_t)written);
+	}
+
+	return 1;
+}
+
+/* returns 0 if the client should be dropped */
+static int handle_client(daemon_t* daemon, client_t* client, short revents) {
+	char buffer[READ_SIZE];
+	ssize_t nread;
+
+	if (revents & POLLIN) {
+		/* drain everything available, then answer it all at once */
+		while ((nread = read(client->fd, buffer, sizeof(buffer))) > 0) {
+			if (!buffer_append(&client->input, buffer, (size_t)nread))
+				return 0;
+			if (!process_input(daemon, client))
+				return 0;
+			if (client->output.size > MAX_PENDING_OUTPUT)
+				break;
+		}
+		if (nread == 0)
+			client->eof = 1;
+		else if (nread < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+			return 0;
+	} else if (revents & (POLLERR | POLLNVAL)) {
+		return 0;
+	} else if ((revents & POLLHUP) && !(revents & POLLOUT)) {
+		return 0;
+	}
+
+	return flush_output(client) && !(client->eof && client->output.size == 0);
+}
+
+static int set_nonblocking(int fd) {
+	int flags = fcntl(fd, F_GETFL);
+	return flags != -1 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) != -1;
+}
+
+/* whether a socket at the path is left by an instance which is gone */
+static int is_stale_socket(const struct sockaddr_un* addr) {
+	struct stat st;
+	int fd, stale;
+
+	if (stat(addr->sun_path, &st) != 0 || !S_ISSOCK(st.st_mode))
+		return 0;
+
+	if ((fd = socket(AF_UNIX, SOCK_STREAM, 0)) == -1)
+		return 0;
+	stale = connect(fd, (const struct sockaddr*)addr, sizeof(*addr)) == -1 && errno == ECONNREFUSED;
+	close(fd);
+
+	return stale;
+}
+
+static int open_socket(const char* path) {
+	struct sockaddr_un addr;
+	int fd;
+
+	if (strlen(path) >= sizeof(addr.sun_path)) {
+		fprintf(stderr, "socket path is too long\n");
+		return -1;
+	}
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strcpy(addr.sun_path, path);
+
+	if ((fd = socket(AF_UNIX, SOCK_STREAM, 0)) == -1) {
+		perror("socket");
+		return -1;
+	}
+
+	/* remove stale socket left by previous instance, but nothing else;
+	 * if another instance is still listening, bind fails below */
+	if (is_stale_socket(&addr))
+		unlink(path);
+
+	if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) == -1 || listen(fd, 128) == -1 || !set_nonblocking(fd)) {
+		perror(path);
+		close(fd);
+		return -1;
+	}
+
+	return fd;
+}
+
+static int serve(daemon_t* daemon, int listen_fd) {
+	struct pollfd* pollfds = NULL;
+	client_t* clients = NULL;
+	size_t num_clients = 0, capacity = 0, i;
+	int fd, res = 0;
+
+	while (!terminate) {
+		if (num_clients + 1 > capacity) {
+			size_t new_capacity = capacity ? capacity * 2 : 64;
+			struct pollfd* new_pollfds = realloc(pollfds, new_capacity * sizeof(struct pollfd));
+			client_t* new_clients;
+			if (new_pollfds != NULL)
+				pollfds = new_pollfds;
+			if (new_pollfds == NULL || (new_clients = realloc(clients, new_capacity * sizeof(client_t))) == NULL) {
+				fprintf(stderr, "out of memory\n");
+				res = 1;
+				break;
+			}
+			clients = new_clients;
+			capacity = new_capacity;
+		}
+
+		/* slot 0 is the listening socket, then clients in order */
+		pollfds[0].fd = listen_fd;
+		pollfds[0].events = POLLIN;
+		for (i = 0; i < num_clients; i++) {
+			pollfds[i + 1].fd = clients[i].fd;
+			/* stop reading from clients which do not read responses */
+			pollfds[i + 1].events = (!clients[i].eof && clients[i].output.size <= MAX_PENDING_OUTPUT ? POLLIN : 0) | (clients[i].output.size > 0 ? POLLOUT : 0);
+		}
+
+		if (poll(pollfds, num_clients + 1, -1) == -1) {
+			if (errno == EINTR)
+				continue;
+			perror("poll");
+			res = 1;
+			break;
+		}
+
+		/* iterate backwards, so dropping a client does not disturb the rest */
+		for (i = num_clients; i > 0; i--) {
+			if (pollfds[i].revents == 0)
+				continue;
+			if (!handle_client(daemon, &clients[i - 1], pollfds[i].revents)) {
+				close(clients[i - 1].fd);
+				buffer_free(&clients[i - 1].input);
+				buffer_free(&clients[i - 1].output);
+				clients[i - 1] = clients[--num_clients];
+			}
+		}
+
+		if (pollfds[0].revents & POLLIN) {
+			while (num_clients < capacity && (fd = accept(listen_fd, NULL, NULL)) != -1) {
+				if (!set_nonblocking(fd)) {
+					close(fd);
+					continue;
+				}
+				memset(&clients[num_clients], 0, sizeof(client_t));
+				clients[num_clients++].fd = fd;
+			}
+		}
+	}
+
+	for (i = 0; i < num_clients; i++) {
+		close(clients[i].fd);
+		buffer_free(&clients[i].input);
+		buffer_free(&clients[i].output);
+	}
+	free(clients);
+	free(pollfds);
+
+	return res;
+}
+
+static void print_version(void) {
+	fprintf(stderr, "libversion %s\n", LIBVERSION_VERSION);
+}
+
+static void print_usage(const char* progname) {
+	fprintf(stderr, "Usage: %s [-pa] [-c cache_size] socket\n", progname);
+	fprintf(stderr, "\n");
+	fprintf(stderr, "Serves version comparison requests on the given unix socket path.\n");
+	fprintf(stderr, "\n");
+	fprintf(stderr, " -p       - 'p' letter is treated as 'patch' instead of 'pre'\n");
+	fprintf(stderr, " -a       - any alphabetic characters are treated as post-release\n");
+	fprintf(stderr, " -c size  - parse cache size in megabytes (default 64)\n");
+	fprintf(stderr, "\n");
+	fprintf(stderr, " -h, -?   - print usage and exit\n");
+	fprintf(stderr, " -v       - print version and exit\n");
+}
+
+int main(int argc, char** argv) {
+	const char* progname = argv[0];
+	size_t cache_size = DEFAULT_CACHE_SIZE;
+	unsigned long megabytes;
+	daemon_t daemon;
+	struct sigaction sa;
+	char* end;
+	int ch, listen_fd, res;
+
+	memset(&daemon, 0, sizeof(daemon));
+
+	while ((ch = getopt(argc, argv, "pac:hv")) != -1) {
+		switch (ch) {
+		case 'p':
+			daemon.flags |= VERSIONFLAG_P_IS_PATCH;
+			break;
+		case 'a':
+			daemon.flags |= VERSIONFLAG_ANY_IS_PATCH;
+			break;
+		case 'c':
+			errno = 0;
+			megabytes = strtoul(optarg, &end, 10);
+			/* strtoul silently negates values starting with minus */
+			if (*optarg == '\0' || *optarg == '-' || *end != '\0' || errno == ERANGE || megabytes > SIZE_MAX / (1024 * 1024)) {
+				print_usage(progname);
+				return 1;
+			}
+			cache_size = (size_t)megabytes * 1024 * 1024;
+			break;
+		case 'h':
+		case '?':
+			print_usage(progname);
+			return 0;
+		case 'v':
+			print_version();
+			return 0;
+		default:
+			print_usage(progname);
+			return 1;
+		}
+	}
+
+	argc -= optind;
+	argv += optind;
+
+	if (argc != 1) {
+		print_usage(progname);
+		return 1;
+	}
+
+	memset(&sa, 0, sizeof(sa));
+	sa.sa_handler = handle_signal;
+	sigaction(SIGINT, &sa, NULL);
+	sigaction(SIGTERM, &sa, NULL);
+	signal(SIGPIPE, SIG_IGN);
+
+	if ((daemon.cache = version_cache_create(cache_size)) == NULL) {
+		fprintf(stderr, "cannot create parse cache\n");
+		return 1;
+	}
+
+	if ((listen_fd = open_socket(argv[0])) == -1) {
+		version_cache_free(daemon.cache);
+		return 1;
+	}
+
+	res = serve(&daemon, listen_fd);
+
+	close(listen_fd);
+	unlink(argv[0]);
+	free(daemon.fields);
+	version_cache_free(daemon.cache);
+
+	return res;
+}
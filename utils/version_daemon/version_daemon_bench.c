@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) 2026 Dmitry Marakasov <amdmi3@amdmi3.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <libversion/config.h>
+
+/* Load generator for version_daemon: each client connection sends
+ * batches of pipelined compare requests and waits for all responses,
+ * measuring round trip time of each batch. */
+
+typedef struct {
+	const char* path;
+	size_t requests;
+	size_t depth;
+	unsigned seed;
+	uint64_t* latencies; /* per batch, in nanoseconds */
+	size_t num_latencies;
+	int failed;
+} client_t;
+
+static const char* versions[] = {
+	"1.0", "1.0.0", "1.0alpha1", "1.0beta2", "1.0rc1", "1.0patch1", "1.0.1", "1.1",
+	"2.0", "2.0.1", "0.9.8za", "1.2.3.4.5", "20190101", "3.14159", "1.0-rc.1", "5.4.0-r3",
+};
+
+#define COUNT(a) (sizeof(a)/sizeof(a[0]))
+
+static uint64_t now_ns(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+}
+
+static unsigned next_random(unsigned* seed) {
+	/* computed in 64 bits so it never wraps */
+	*seed = (unsigned)(((uint64_t)*seed * 1103515245u + 12345u) & 0x7fffffff);
+	return *seed >> 8;
+}
+
+static int connect_socket(const char* path) {
+	struct sockaddr_un addr;
+	int fd;
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+
+	if ((fd = socket(AF_UNIX, SOCK_STREAM, 0)) == -1)
+		return -1;
+
+	if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) == -1) {
+		close(fd);
+		return -1;
+	}
+
+	return fd;
+}
+
+static int write_all(int fd, const char* data, size_t length) {
+	ssize_t written;
+
+	while (length > 0) {
+		if ((written = write(fd, data, length)) < 0) {
+			if (errno == EINTR)
+				continue;
+			return 0;
+		}
+		data += written;
+		length -= (size_t)written;
+	}
+
+	return 1;
+}
+
+/* reads until given number of response lines arrive */
+static int read_responses(int fd, size_t count) {
+	char buffer[65536];
+	ssize_t nread, i;
+
+	while (count > 0) {
+		if ((nread = read(fd, buffer, sizeof(buffer))) <= 0) {
+			if (nread < 0 && errno == EINTR)
+				continue;
+			return 0;
+		}
+		for (i = 0; i < nread; i++)
+			if (buffer[i] == '\n')
+				count--;
+	}
+
+	return 1;
+}
+
+static void* client_main(void* arg) {
+	client_t* client = (client_t*)arg;
+	size_t batch_size = client->depth * 64, length, sent = 0, i;
+	char* batch;
+	uint64_t start;
+	int fd;
+
+	if ((batch = malloc(batch_size)) == NULL || (fd = connect_socket(client->path)) == -1) {
+		free(batch);
+		client->failed = 1;
+		return NULL;
+	}
+
+	while (sent < client->requests) {
+		size_t depth = client->requests - sent < client->depth ? client->requests - sent : client->depth;
+
+		for (length = 0, i = 0; i < depth; i++) {
+			length += (size_t)snprintf(batch + length, batch_size - length, "compare %s %s\n",
+				versions[next_random(&client->seed) % COUNT(versions)],
+				versions[next_random(&client->seed) % COUNT(versions)]);
+		}
+
+		start = now_ns();
+		if (!write_all(fd, batch, length) || !read_responses(fd, depth)) {
+			client->failed = 1;
+			break;
+		}
+		client->latencies[client->num_latencies++] = now_ns() - start;
+
+		sent += depth;
+	}
+
+	close(fd);
+	free(batch);
+	return NULL;
+}
+
+static int compare_latencies(const void* a, const void* b) {
+	uint64_t la = *(const uint64_t*)a;
+	uint64_t lb = *(const uint64_t*)b;
+	return (la > lb) - (la < lb);
+}
+
+static void print_version(void) {
+	fprintf(stderr, "libversion %s\n", LIBVERSION_VERSION);
+}
+
+static void print_usage(const char* progname) {
+	fprintf(stderr, "Usage: %s [-c clients] [-n requests] [-d depth] socket\n", progname);
+	fprintf(stderr, "\n");
+	fprintf(stderr, "Measures version_daemon throughput and latency.\n");
+	fprintf(stderr, "\n");
+	fprintf(stderr, " -c clients  - number of concurrent connections (default 4)\n");
+	fprintf(stderr, " -n requests - number of requests per connection (default 100000)\n");
+	fprintf(stderr, " -d depth    - number of pipelined requests per batch (default 100)\n");
+	fprintf(stderr, "\n");
+	fprintf(stderr, " -h, -?      - print usage and exit\n");
+	fprintf(stderr, " -v          - print version and exit\n");
+}
+
+static int parse_count(const char* arg, size_t* count) {
+	char* end;
+	unsigned long value = strtoul(arg, &end, 10);
+	if (*arg == '\0' || *end != '\0' || value == 0)
+		return 0;
+	*count = (size_t)value;
+	return 1;
+}
+
+int main(int argc, char** argv) {
+	const char* progname = argv[0];
+	size_t num_clients = 4, requests = 100000, depth = 100, i, total_batches = 0, pos;
+	client_t* clients;
+	pthread_t* threads;
+	uint64_t* latencies;
+	uint64_t start, elapsed;
+	int ch, failed = 0;
+
+	while ((ch = getopt(argc, argv, "c:n:d:hv")) != -1) {
+		switch (ch) {
+		case 'c':
+		case 'n':
+		case 'd':
+			if (!parse_count(optarg, ch == 'c' ? &num_clients : ch == 'n' ? &requests : &depth)) {
+				print_usage(progname);
+				return 1;
+			}
+			break;
+		case 'h':
+		case '?':
+			print_usage(progname);
+			return 0;
+		case 'v':
+			print_version();
+			return 0;
+		default:
+			print_usage(progname);
+			return 1;
+		}
+	}
+
+	argc -= optind;
+	argv += optind;
+
+	if (argc != 1) {
+		print_usage(progname);
+		return 1;
+	}
+
+	clients = calloc(num_clients, sizeof(client_t));
+	threads = calloc(num_clients, sizeof(pthread_t));
+	if (clients == NULL || threads == NULL) {
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+
+	for (i = 0; i < num_clients; i++) {
+		clients[i].path = argv[0];
+		clients[i].requests = requests;
+		clients[i].depth = depth;
+		clients[i].seed = (unsigned)i + 1;
+		if ((clients[i].latencies = malloc((requests / depth + 1) * sizeof(uint64_t))) == NULL) {
+			fprintf(stderr, "out of memory\n");
+			return 1;
+		}
+	}
+
+	start = now_ns();
+	for (i = 0; i < num_clients; i++)
+		pthread_create(&threads[i], NULL, client_main, &clients[i]);
+	for (i = 0; i < num_clients; i++)
+		pthread_join(threads[i], NULL);
+	elapsed = now_ns() - start;
+
+	for (i = 0; i < num_clients; i++) {
+		failed |= clients[i].failed;
+		total_batches += clients[i].num_latencies;
+	}
+
+	if (failed) {
+		fprintf(stderr, "some connections failed\n");
+		return 1;
+	}
+
+	if ((latencies = malloc(total_batches * sizeof(uint64_t) + 1)) == NULL) {
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+	for (pos = 0, i = 0; i < num_clients; i++) {
+		memcpy(latencies + pos, clients[i].latencies, clients[i].num_latencies * sizeof(uint64_t));
+		pos += clients[i].num_latencies;
+		free(clients[i].latencies);
+	}
+	qsort(latencies, total_batches, sizeof(uint64_t), compare_latencies);
+
+	printf("clients:     %lu\n", (unsigned long)num_clients);
+	printf("requests:    %lu\n", (unsigned long)(num_clients * requests));
+	printf("depth:       %lu\n", (unsigned long)depth);
+	printf("elapsed:     %.3f s\n", (double)elapsed / 1e9);
+	printf("throughput:  %.0f requests/s\n", (double)(num_clients * requests) / ((double)elapsed / 1e9));
+	if (total_batches > 0) {
+		printf("batch p50:   %.1f us\n", (double)latencies[total_batches / 2] / 1e3);
+		printf("batch p90:   %.1f us\n", (double)latencies[total_batches * 9 / 10] / 1e3);
+		printf("batch p99:   %.1f us\n", (double)latencies[total_batches * 99 / 100] / 1e3);
+		printf("batch max:   %.1f us\n", (double)latencies[total_batches - 1] / 1e3);
+	}
+
+	free(latencies);
+	free(threads);
+	free(clients);
+
+	return 0;
+}
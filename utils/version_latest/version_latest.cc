@@ -0,0 +1,362 @@
+// Copyright (c) 2019 Dmitry Marakasov <amdmi3@amdmi3.ru>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <getopt.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <libversion/config.h>
+#include <libversion/version.h>
+
+// version along with its sort key
+struct Entry {
+	std::string key;
+	std::string version;
+};
+
+// Best versions seen for each key. Every version is parsed once into
+// a sort key, and only sort keys are compared afterwards
+class LatestVersions {
+private:
+	int flags_;
+	size_t count_;
+	bool oldest_;
+	std::unordered_map<std::string, std::vector<Entry>> groups_;
+	Entry candidate_;
+
+	// whether a should be listed before b; equal versions are ordered stringwise,
+	// so the result does not depend on input order
+	bool Better(const Entry& a, const Entry& b) const {
+		int res = a.key.compare(b.key);
+		if (res == 0) {
+			res = a.version.compare(b.version);
+		}
+		return oldest_ ? res < 0 : res > 0;
+	}
+
+	void MakeKey(Entry& entry) const {
+		entry.key.resize(std::max(entry.key.capacity(), entry.version.size() * 2 + 1));
+		size_t length = version_sort_key(entry.version.c_str(), flags_, reinterpret_cast<unsigned char*>(&entry.key[0]), entry.key.size());
+		if (length > entry.key.size()) {
+			entry.key.resize(length);
+			version_sort_key(entry.version.c_str(), flags_, reinterpret_cast<unsigned char*>(&entry.key[0]), entry.key.size());
+		}
+		entry.key.resize(length);
+	}
+
+public:
+	LatestVersions(int flags, size_t count, bool oldest) : flags_(flags), count_(count), oldest_(oldest) {
+	}
+
+	void Add(const std::string& group, const std::string& version) {
+		candidate_.version = version;
+		MakeKey(candidate_);
+
+		// entries are kept ordered from best to worst
+		std::vector<Entry>& entries = groups_[group];
+		if (entries.size() == count_ && !Better(candidate_, entries.back())) {
+			return;
+		}
+
+		auto pos = std::lower_bound(
+			entries.begin(),
+			entries.end(),
+			candidate_,
+			[this](const Entry& a, const Entry& b) -> bool {
+				return Better(a, b);
+			}
+		);
+		if (pos != entries.end() && pos->version == candidate_.version) {
+			return;  // same version seen again, e.g. in another repository
+		}
+
+		entries.insert(pos, candidate_);
+		if (entries.size() > count_) {
+			entries.pop_back();
+		}
+	}
+
+	template <class Callback>
+	void ForEachGroup(Callback callback) const {
+		for (const auto& group: groups_) {
+			callback(group.first, group.second);
+		}
+	}
+};
+
+typedef std::vector<std::pair<std::string, std::string>> Batch;
+
+// hands batches of lines over to a worker thread; nullptr means end of input
+class BatchQueue {
+private:
+	static constexpr size_t max_queued_ = 4;
+
+	std::mutex mutex_;
+	std::condition_variable cond_;
+	std::deque<std::unique_ptr<Batch>> batches_;
+
+public:
+	void Push(std::unique_ptr<Batch> batch) {
+		std::unique_lock<std::mutex> lock(mutex_);
+		cond_.wait(lock, [this]() { return batches_.size() < max_queued_; });
+		batches_.push_back(std::move(batch));
+		cond_.notify_all();
+	}
+
+	std::unique_ptr<Batch> Pop() {
+		std::unique_lock<std::mutex> lock(mutex_);
+		cond_.wait(lock, [this]() { return !batches_.empty(); });
+		std::unique_ptr<Batch> batch = std::move(batches_.front());
+		batches_.pop_front();
+		cond_.notify_all();
+		return batch;
+	}
+};
+
+// keys are sharded across threads, so each thread owns its own part of the results
+class ShardedLatestVersions {
+private:
+	static constexpr size_t batch_size_ = 1024;
+
+	struct Shard {
+		LatestVersions latest;
+		BatchQueue queue;
+		std::unique_ptr<Batch> pending;
+		std::thread thread;
+
+		Shard(int flags, size_t count, bool oldest) : latest(flags, count, oldest), pending(new Batch) {
+		}
+	};
+
+	std::vector<std::unique_ptr<Shard>> shards_;
+	std::hash<std::string> hash_;
+
+	static void Work(Shard* shard) {
+		while (std::unique_ptr<Batch> batch = shard->queue.Pop()) {
+			for (const auto& item: *batch) {
+				shard->latest.Add(item.first, item.second);
+			}
+		}
+	}
+
+public:
+	ShardedLatestVersions(size_t threads, int flags, size_t count, bool oldest) {
+		for (size_t i = 0; i < threads; ++i) {
+			shards_.emplace_back(new Shard(flags, count, oldest));
+			shards_.back()->thread = std::thread(Work, shards_.back().get());
+		}
+	}
+
+	void Add(std::string&& group, std::string&& version) {
+		Shard& shard = *shards_[hash_(group) % shards_.size()];
+		shard.pending->emplace_back(std::move(group), std::move(version));
+		if (shard.pending->size() >= batch_size_) {
+			shard.queue.Push(std::move(shard.pending));
+			shard.pending.reset(new Batch);
+		}
+	}
+
+	void Finish() {
+		for (auto& shard: shards_) {
+			shard->queue.Push(std::move(shard->pending));
+			shard->queue.Push(nullptr);
+		}
+		for (auto& shard: shards_) {
+			shard->thread.join();
+		}
+	}
+
+	template <class Callback>
+	void ForEachGroup(Callback callback) const {
+		for (const auto& shard: shards_) {
+			shard->latest.ForEachGroup(callback);
+		}
+	}
+};
+
+template <class Results>
+static void Dump(const Results& results, char delimiter, std::ostream& stream) {
+	typedef std::pair<const std::string*, const std::vector<Entry>*> Group;
+	std::vector<Group> groups;
+
+	results.ForEachGroup([&groups](const std::string& group, const std::vector<Entry>& entries) {
+		groups.emplace_back(&group, &entries);
+	});
+
+	// output is ordered by key so it does not depend on hashing or threads
+	std::sort(groups.begin(), groups.end(), [](const Group& a, const Group& b) -> bool {
+		return *a.first < *b.first;
+	});
+
+	for (const auto& group: groups) {
+		for (const auto& entry: *group.second) {
+			stream << *group.first << delimiter << entry.version << '\n';
+		}
+	}
+}
+
+static void print_version() {
+	std::cerr << "libversion " << LIBVERSION_VERSION << std::endl;
+}
+
+static void print_usage(const char* progname) {
+	std::cerr << "Usage: " << progname << " [-pal] [-n count] [-t delim] [-j threads] [path ...]\n";
+	std::cerr << "\n";
+	std::cerr << "Reads lines of form <key><delim><version> and prints the newest version for each key\n";
+	std::cerr << "\n";
+	std::cerr << " -p         - 'p' letter is treated as 'patch' instead of 'pre'\n";
+	std::cerr << " -a         - any alphabetic characters are treated as post-release\n";
+	std::cerr << " -n count   - print up to count newest versions for each key\n";
+	std::cerr << " -l         - print oldest versions instead of newest\n";
+	std::cerr << " -t delim   - key and version delimiter character (default is tab)\n";
+	std::cerr << " -j threads - number of threads to process input with\n";
+	std::cerr << "\n";
+	std::cerr << " -h, -?     - print usage and exit\n";
+	std::cerr << " -V         - print version and exit" << std::endl;
+}
+
+static bool parse_count(const char* arg, size_t& count) {
+	char* end;
+	long value = std::strtol(arg, &end, 10);
+	if (*arg == '\0' || *end != '\0' || value < 1) {
+		return false;
+	}
+	count = static_cast<size_t>(value);
+	return true;
+}
+
+// calls back with key and version for each line; version is the second field
+template <class Callback>
+static void Read(std::istream& stream, const char* name, char delimiter, Callback callback) {
+	std::string line;
+	size_t lineno = 0;
+
+	while (std::getline(stream, line)) {
+		++lineno;
+		size_t pos = line.find(delimiter);
+		if (pos == std::string::npos) {
+			std::cerr << name << ":" << lineno << ": no version, skipped" << std::endl;
+			continue;
+		}
+		size_t end = line.find(delimiter, pos + 1);
+		callback(line.substr(0, pos), line.substr(pos + 1, end == std::string::npos ? std::string::npos : end - pos - 1));
+	}
+}
+
+template <class Callback>
+static bool ReadAll(int argc, char** argv, char delimiter, Callback callback) {
+	if (argc == 0) {
+		Read(std::cin, "-", delimiter, callback);
+	}
+	for (int arg = 0; arg < argc; ++arg) {
+		std::ifstream fs(argv[arg]);
+		if (!fs) {
+			std::cerr << "cannot open " << argv[arg] << std::endl;
+			return false;
+		}
+		Read(fs, argv[arg], delimiter, callback);
+	}
+	return true;
+}
+
+int main(int argc, char** argv) {
+	int ch, flags = 0;
+	const char* progname = argv[0];
+	size_t count = 1, threads = 1;
+	bool oldest = false;
+	char delimiter = '\t';
+
+	while ((ch = getopt(argc, argv, "palhVn:t:j:")) != -1) {
+		switch (ch) {
+		case 'p':
+			flags |= VERSIONFLAG_P_IS_PATCH;
+			break;
+		case 'a':
+			flags |= VERSIONFLAG_ANY_IS_PATCH;
+			break;
+		case 'l':
+			oldest = true;
+			break;
+		case 'n':
+			if (!parse_count(optarg, count)) {
+				std::cerr << "bad count " << optarg << std::endl;
+				return 1;
+			}
+			break;
+		case 't':
+			if (std::strcmp(optarg, "\\t") != 0 && std::strlen(optarg) != 1) {
+				std::cerr << "delimiter must be a single character" << std::endl;
+				return 1;
+			}
+			delimiter = std::strcmp(optarg, "\\t") == 0 ? '\t' : *optarg;
+			break;
+		case 'j':
+			if (!parse_count(optarg, threads)) {
+				std::cerr << "bad number of threads " << optarg << std::endl;
+				return 1;
+			}
+			break;
+		case 'h':
+		case '?':
+			print_usage(progname);
+			return 0;
+		case 'V':
+			print_version();
+			return 0;
+		default:
+			print_usage(progname);
+			return 1;
+		}
+	}
+
+	argc -= optind;
+	argv += optind;
+
+	if (threads == 1) {
+		LatestVersions latest(flags, count, oldest);
+		bool ok = ReadAll(argc, argv, delimiter, [&latest](std::string&& key, std::string&& version) {
+			latest.Add(key, version);
+		});
+		Dump(latest, delimiter, std::cout);
+		return ok ? 0 : 1;
+	}
+
+	ShardedLatestVersions latest(threads, flags, count, oldest);
+	bool ok = ReadAll(argc, argv, delimiter, [&latest](std::string&& key, std::string&& version) {
+		latest.Add(std::move(key), std::move(version));
+	});
+	latest.Finish();
+	Dump(latest, delimiter, std::cout);
+	return ok ? 0 : 1;
+}
@@ -21,64 +21,333 @@
 #include <getopt.h>
 
 #include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <queue>
 #include <string>
 #include <vector>
 
 #include <libversion/config.h>
+#include <libversion/set.h>
+#include <libversion/stats.h>
 #include <libversion/version.h>
 
-class VersionsList {
+// Lines are ordered by version, which is either the whole line, or
+// one of the fields separated by delimiter, then by optional extra
+// fields compared as plain strings, then by the whole line
+class RecordOrder {
 private:
 	int flags_;
-	std::vector<std::string> versions_;
+	bool split_ = false;
+	char delimiter_ = '\t';
+	size_t version_field_ = 0;
+	std::vector<size_t> string_fields_;
 
-	bool VersionLess(const std::string& a, const std::string& b) const {
-		int res = version_compare4(a.c_str(), b.c_str(), flags_, flags_);
-		if (res < 0) {
-			return true;
+	// [begin, end) of the field, empty range at end of line if there's no such field
+	std::pair<size_t, size_t> Field(const std::string& line, size_t index) const {
+		if (!split_) {
+			return std::make_pair(size_t(0), line.size());
 		}
-		if (res > 0) {
-			return false;
+
+		size_t begin = 0;
+		for (; index > 0; --index) {
+			size_t pos = line.find(delimiter_, begin);
+			if (pos == std::string::npos) {
+				return std::make_pair(line.size(), line.size());
+			}
+			begin = pos + 1;
+		}
+
+		size_t end = line.find(delimiter_, begin);
+		return std::make_pair(begin, end == std::string::npos ? line.size() : end);
+	}
+
+public:
+	RecordOrder(int flags) : flags_(flags) {
+	}
+
+	void SetDelimiter(char delimiter) {
+		split_ = true;
+		delimiter_ = delimiter;
+	}
+
+	void SetVersionField(size_t field) {
+		split_ = true;
+		version_field_ = field;
+	}
+
+	void AddStringField(size_t field) {
+		split_ = true;
+		string_fields_.push_back(field);
+	}
+
+	bool IsSplit() const {
+		return split_;
+	}
+
+	int Flags() const {
+		return flags_;
+	}
+
+	// parses version field in place, so the line is temporarily modified
+	void MakeKey(std::string& line, std::string& key, uint64_t* abbreviated_key = nullptr) const {
+		auto field = Field(line, version_field_);
+		char saved = '\0';
+		if (field.second < line.size()) {
+			std::swap(line[field.second], saved);
+		}
+
+		const char* version = line.c_str() + field.first;
+		key.resize(std::max(key.capacity(), (field.second - field.first) * 2 + 1));
+		size_t length = version_sort_key(version, flags_, reinterpret_cast<unsigned char*>(&key[0]), key.size());
+		if (length > key.size()) {
+			key.resize(length);
+			version_sort_key(version, flags_, reinterpret_cast<unsigned char*>(&key[0]), key.size());
+		}
+		key.resize(length);
+
+		if (field.second < line.size()) {
+			std::swap(line[field.second], saved);
+		}
+
+		if (abbreviated_key != nullptr) {
+			*abbreviated_key = version_abbreviate_sort_key(reinterpret_cast<const unsigned char*>(key.data()), key.size());
+		}
+	}
+
+	// sort keys compare the same way as versions do
+	bool Less(const std::string& a_key, const std::string& a, const std::string& b_key, const std::string& b) const {
+		if (a_key != b_key) {
+			return a_key < b_key;
+		}
+
+		for (const auto index: string_fields_) {
+			auto a_field = Field(a, index);
+			auto b_field = Field(b, index);
+			int res = a.compare(a_field.first, a_field.second - a_field.first, b, b_field.first, b_field.second - b_field.first);
+			if (res != 0) {
+				return res < 0;
+			}
 		}
 
 		return a < b;  // fallback to stringwise comparison for stable ordering
 	}
+};
+
+class VersionsList {
+private:
+	struct Record {
+		std::string line;
+		std::string key;
+		uint64_t abbreviated_key;
+	};
+
+	const RecordOrder& order_;
+	std::vector<Record> records_;
 
 public:
-	VersionsList(int flags) : flags_(flags) {
+	VersionsList(const RecordOrder& order) : order_(order) {
 	}
 
+	// each line is parsed once when it's read
 	void Read(std::istream& stream) {
-		std::string line;
-		while (std::getline(stream, line)) {
-			versions_.push_back(line);
+		Record record;
+		while (std::getline(stream, record.line)) {
+			order_.MakeKey(record.line, record.key, &record.abbreviated_key);
+			records_.push_back(record);
 		}
 	}
 
 	void Sort() {
 		std::sort(
-			versions_.begin(),
-			versions_.end(),
-			[this](const std::string& a, const std::string& b) -> bool {
-				return VersionLess(a, b);
+			records_.begin(),
+			records_.end(),
+			[this](const Record& a, const Record& b) -> bool {
+				// abbreviated keys decide most pairs without touching the strings
+				if (a.abbreviated_key != b.abbreviated_key) {
+					return a.abbreviated_key < b.abbreviated_key;
+				}
+				return order_.Less(a.key, a.line, b.key, b.line);
 			}
 		);
 	}
 
 	void Dump(std::ostream& stream) const {
-		for (const auto& version: versions_) {
-			stream << version << '\n';
+		for (const auto& record: records_) {
+			stream << record.line << '\n';
 		}
 	}
 
+	bool WriteIndex(const char* path) const {
+		std::vector<const char*> strings;
+		for (const auto& record: records_) {
+			strings.push_back(record.line.c_str());
+		}
+
+		version_set_t* set = version_set_build(strings.data(), strings.size(), order_.Flags());
+		if (set == nullptr) {
+			return false;
+		}
+
+		bool res = version_set_write(set, path);
+		version_set_free(set);
+		return res;
+	}
+
 	void VerboseDump(std::ostream& stream) const {
-		std::string prev;
-		for (const auto& version: versions_) {
-			stream << version << (VersionLess(prev, version) ? " (<)" : " (==)") << '\n';
-			prev = version;
+		Record prev;
+		order_.MakeKey(prev.line, prev.key);
+		for (const auto& record: records_) {
+			stream << record.line << (order_.Less(prev.key, prev.line, record.key, record.line) ? " (<)" : " (==)") << '\n';
+			prev = record;
+		}
+	}
+};
+
+// pre-sorted input, each line is only parsed once when it's read
+class SortedInput {
+private:
+	std::unique_ptr<std::ifstream> file_;
+	std::istream* stream_;
+	std::string line_;
+	std::string key_;
+
+public:
+	SortedInput(std::istream* stream) : stream_(stream) {
+	}
+
+	SortedInput(const char* path) : file_(new std::ifstream(path)), stream_(file_.get()) {
+	}
+
+	bool IsOpen() const {
+		return !stream_->fail();
+	}
+
+	bool Next(const RecordOrder& order) {
+		if (!std::getline(*stream_, line_)) {
+			return false;
 		}
+		order.MakeKey(line_, key_);
+		return true;
+	}
+
+	const std::string& Line() const {
+		return line_;
+	}
+
+	const std::string& Key() const {
+		return key_;
+	}
+};
+
+static void Merge(std::vector<SortedInput>& inputs, const RecordOrder& order, bool verbose, std::ostream& stream) {
+	auto greater = [&inputs, &order](size_t a, size_t b) -> bool {
+		return order.Less(inputs[b].Key(), inputs[b].Line(), inputs[a].Key(), inputs[a].Line());
+	};
+	std::priority_queue<size_t, std::vector<size_t>, decltype(greater)> heap(greater);
+
+	for (size_t i = 0; i < inputs.size(); ++i) {
+		if (inputs[i].Next(order)) {
+			heap.push(i);
+		}
+	}
+
+	// same as VersionsList::VerboseDump, first line is compared to an empty one
+	std::string prev, prev_key;
+	order.MakeKey(prev, prev_key);
+
+	while (!heap.empty()) {
+		SortedInput& input = inputs[heap.top()];
+		heap.pop();
+
+		if (verbose) {
+			stream << input.Line() << (order.Less(prev_key, prev, input.Key(), input.Line()) ? " (<)" : " (==)") << '\n';
+			prev = input.Line();
+			prev_key = input.Key();
+		} else {
+			stream << input.Line() << '\n';
+		}
+
+		if (input.Next(order)) {
+			heap.push(&input - inputs.data());
+		}
+	}
+}
+
+// only keeps current and previous lines, each one is parsed once
+static bool CheckSorted(std::istream& stream, const char* name, const RecordOrder& order) {
+	std::string line, key, prev, prev_key;
+	size_t lineno = 0;
+
+	while (std::getline(stream, line)) {
+		++lineno;
+		order.MakeKey(line, key);
+		if (lineno > 1 && order.Less(key, line, prev_key, prev)) {
+			std::cerr << name << ":" << lineno << ": disorder: " << line << std::endl;
+			return false;
+		}
+		std::swap(line, prev);
+		std::swap(key, prev_key);
+	}
+
+	return true;
+}
+
+static bool parse_field(const char* arg, size_t& field) {
+	char* end;
+	long value = std::strtol(arg, &end, 10);
+	if (*arg == '\0' || *end != '\0' || value < 1) {
+		return false;
+	}
+	field = static_cast<size_t>(value - 1);
+	return true;
+}
+
+// prints library statistics when leaving scope, so it works for any exit path
+class StatsReporter {
+private:
+	bool enabled_ = false;
+
+public:
+	~StatsReporter() {
+		if (!enabled_) {
+			return;
+		}
+
+		version_stats_t stats;
+		if (!version_stats_snapshot(&stats)) {
+			std::cerr << "statistics are not available: libversion was built without LIBVERSION_STATS" << std::endl;
+			return;
+		}
+
+		// version_sort orders by sort keys, so it normally makes no compare calls
+		std::cerr << "sort keys built:          " << stats.key_calls << "\n";
+		std::cerr << "abbreviated keys built:   " << stats.abbreviated_key_calls << "\n";
+		std::cerr << "library key comparisons:  " << stats.key_compare_calls << "\n";
+		std::cerr << "compare calls:            " << stats.compare_calls << "\n";
+		std::cerr << "equal results:            " << stats.equal_results << "\n";
+		std::cerr << "components parsed:        " << stats.components_parsed << "\n";
+		std::cerr << "padding components:       " << stats.padding_components << "\n";
+		std::cerr << "letter suffix lookaheads: " << stats.letter_suffix_lookaheads << "\n";
+		std::cerr << "unknown keywords:         " << stats.keywords_unknown << "\n";
+		std::cerr << "pre-release keywords:     " << stats.keywords_pre_release << "\n";
+		std::cerr << "post-release keywords:    " << stats.keywords_post_release << "\n";
+		std::cerr << "release keywords:         " << stats.keywords_release << "\n";
+		std::cerr << "compare calls decided at component:\n";
+		for (size_t i = 0; i < VERSION_STATS_DECISION_DEPTH; ++i) {
+			if (stats.decided_at[i] != 0) {
+				std::cerr << "  " << i << (i + 1 == VERSION_STATS_DECISION_DEPTH ? "+" : "") << ": " << stats.decided_at[i] << "\n";
+			}
+		}
+		std::cerr << std::flush;
+	}
+
+	void Enable() {
+		enabled_ = true;
 	}
 };
 
@@ -87,11 +356,21 @@ static void print_version() {
 }
 
 static void print_usage(const char* progname) {
-	std::cerr << "Usage: " << progname << " [-pa] [path]\n";
+	std::cerr << "Usage: " << progname << " [-pavms] [-t delim] [-f field] [-k field ...] [-o index] [path ...]\n";
+	std::cerr << "       " << progname << " -c [-pas] [-t delim] [-f field] [-k field ...] [path]\n";
 	std::cerr << "\n";
 	std::cerr << " -p       - 'p' letter is treated as 'patch' instead of 'pre'\n";
 	std::cerr << " -a       - any alphabetic characters are treated as post-release\n";
 	std::cerr << " -v       - verbose mode (display whether version is different from the previous one)\n";
+	std::cerr << " -m       - merge already sorted inputs\n";
+	std::cerr << " -c       - check whether input is sorted, report first out of order line\n";
+	std::cerr << " -o index - write sorted versions into index file (see libversion/set_file.h)\n";
+	std::cerr << " -s       - print library statistics when done (needs libversion built with LIBVERSION_STATS)\n";
+	std::cerr << "\n";
+	std::cerr << " -t delim - split lines into fields separated by delim character (default is tab)\n";
+	std::cerr << " -f field - number of field which contains version (starting with 1)\n";
+	std::cerr << " -k field - number of field to compare as a plain string when versions are equal,\n";
+	std::cerr << "            may be specified multiple times\n";
 	std::cerr << "\n";
 	std::cerr << " -h, -?   - print usage and exit\n";
 	std::cerr << " -V       - print version and exit" << std::endl;
@@ -100,9 +379,17 @@ static void print_usage(const char* progname) {
 int main(int argc, char** argv) {
 	int ch, flags = 0;
 	const char* progname = argv[0];
+	const char* index_path = nullptr;
 	bool verbose = false;
+	bool merge = false;
+	bool check = false;
+	const char* delimiter = nullptr;
+	size_t version_field = 0, field;
+	bool has_version_field = false;
+	std::vector<size_t> string_fields;
+	StatsReporter stats_reporter;
 
-	while ((ch = getopt(argc, argv, "pahvV")) != -1) {
+	while ((ch = getopt(argc, argv, "pahvVmcso:t:f:k:")) != -1) {
 		switch (ch) {
 		case 'p':
 			flags |= VERSIONFLAG_P_IS_PATCH;
@@ -120,6 +407,42 @@ int main(int argc, char** argv) {
 		case 'v':
 			verbose = true;
 			break;
+		case 'm':
+			merge = true;
+			break;
+		case 'c':
+			check = true;
+			break;
+		case 's':
+			stats_reporter.Enable();
+			break;
+		case 'o':
+			index_path = optarg;
+			break;
+		case 't':
+			delimiter = optarg;
+			if (std::strcmp(delimiter, "\\t") == 0) {
+				delimiter = "\t";
+			}
+			if (std::strlen(delimiter) != 1) {
+				std::cerr << "delimiter must be a single character" << std::endl;
+				return 1;
+			}
+			break;
+		case 'f':
+			if (!parse_field(optarg, version_field)) {
+				std::cerr << "bad field number " << optarg << std::endl;
+				return 1;
+			}
+			has_version_field = true;
+			break;
+		case 'k':
+			if (!parse_field(optarg, field)) {
+				std::cerr << "bad field number " << optarg << std::endl;
+				return 1;
+			}
+			string_fields.push_back(field);
+			break;
 		default:
 			print_usage(progname);
 			return 1;
@@ -129,7 +452,56 @@ int main(int argc, char** argv) {
 	argc -= optind;
 	argv += optind;
 
-	VersionsList versions(flags);
+	RecordOrder order(flags);
+	if (delimiter != nullptr) {
+		order.SetDelimiter(*delimiter);
+	}
+	if (has_version_field) {
+		order.SetVersionField(version_field);
+	}
+	for (const auto string_field: string_fields) {
+		order.AddStringField(string_field);
+	}
+
+	if (index_path != nullptr && order.IsSplit()) {
+		std::cerr << "index file can only be built from plain versions" << std::endl;
+		return 1;
+	}
+
+	if (check) {
+		if (argc > 1) {
+			print_usage(progname);
+			return 1;
+		}
+		if (argc == 0) {
+			return CheckSorted(std::cin, "-", order) ? 0 : 1;
+		}
+		std::ifstream fs(argv[0]);
+		if (!fs) {
+			std::cerr << "cannot open " << argv[0] << std::endl;
+			return 1;
+		}
+		return CheckSorted(fs, argv[0], order) ? 0 : 1;
+	}
+
+	if (merge && index_path == nullptr) {
+		std::vector<SortedInput> inputs;
+		if (argc == 0) {
+			inputs.emplace_back(&std::cin);
+		}
+		for (int arg = 0; arg < argc; ++arg) {
+			inputs.emplace_back(argv[arg]);
+			if (!inputs.back().IsOpen()) {
+				std::cerr << "cannot open " << argv[arg] << std::endl;
+				return 1;
+			}
+		}
+
+		Merge(inputs, order, verbose, std::cout);
+		return 0;
+	}
+
+	VersionsList versions(order);
 
 	if (argc == 0) {
 		versions.Read(std::cin);
@@ -139,6 +511,14 @@ int main(int argc, char** argv) {
 		versions.Read(fs);
 	}
 
+	if (index_path != nullptr) {
+		if (!versions.WriteIndex(index_path)) {
+			std::cerr << "cannot write index file " << index_path << std::endl;
+			return 1;
+		}
+		return 0;
+	}
+
 	versions.Sort();
 
 	if (verbose) {